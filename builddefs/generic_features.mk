@@ -47,6 +47,7 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    SCAN_PROFILER \
     SECURE \
     SEND_STRING \
     SEQUENCER \
@@ -55,6 +56,7 @@ GENERIC_FEATURES = \
     TAP_DANCE \
     TRI_LAYER \
     VIA \
+    VIA_BULK \
     VIRTSER \
     WPM \
 
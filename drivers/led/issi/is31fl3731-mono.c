@@ -21,6 +21,7 @@
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
+#include <string.h>
 
 #define IS31FL3731_PWM_REGISTER_COUNT 144
 #define IS31FL3731_LED_CONTROL_REGISTER_COUNT 18
@@ -33,6 +34,14 @@
 #    define IS31FL3731_I2C_PERSISTENCE 0
 #endif
 
+// Longest PWM register run sent in a single transfer
+#define IS31FL3731_PWM_BURST_LENGTH 16
+
+// Clean registers between two dirty ones that are cheaper to resend than to start a new transfer for
+#ifndef IS31FL3731_PWM_BURST_GAP
+#    define IS31FL3731_PWM_BURST_GAP 2
+#endif
+
 const uint8_t i2c_addresses[IS31FL3731_DRIVER_COUNT] = {
     IS31FL3731_I2C_ADDRESS_1,
 #ifdef IS31FL3731_I2C_ADDRESS_2
@@ -48,21 +57,22 @@ const uint8_t i2c_addresses[IS31FL3731_DRIVER_COUNT] = {
 
 // These buffers match the IS31FL3731 PWM registers 0x24-0xB3.
 // Storing them like this is optimal for I2C transfers to the registers.
-// We could optimize this and take out the unused registers from these
-// buffers and the transfers in is31fl3731_write_pwm_buffer() but it's
-// probably not worth the extra complexity.
+// Each PWM register also has a dirty bit, so that only the registers
+// that changed since the last update are transferred.
 typedef struct is31fl3731_driver_t {
     uint8_t pwm_buffer[IS31FL3731_PWM_REGISTER_COUNT];
+    uint8_t pwm_buffer_dirty_registers[IS31FL3731_PWM_REGISTER_COUNT / 8];
     bool    pwm_buffer_dirty;
     uint8_t led_control_buffer[IS31FL3731_LED_CONTROL_REGISTER_COUNT];
     bool    led_control_buffer_dirty;
 } PACKED is31fl3731_driver_t;
 
 is31fl3731_driver_t driver_buffers[IS31FL3731_DRIVER_COUNT] = {{
-    .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
-    .led_control_buffer       = {0},
-    .led_control_buffer_dirty = false,
+    .pwm_buffer                 = {0},
+    .pwm_buffer_dirty_registers = {0},
+    .pwm_buffer_dirty           = false,
+    .led_control_buffer         = {0},
+    .led_control_buffer_dirty   = false,
 }};
 
 void is31fl3731_write_register(uint8_t index, uint8_t reg, uint8_t data) {
@@ -79,20 +89,53 @@ void is31fl3731_select_page(uint8_t index, uint8_t page) {
     is31fl3731_write_register(index, IS31FL3731_REG_COMMAND, page);
 }
 
+static void is31fl3731_write_pwm_registers(uint8_t index, uint8_t offset, uint8_t length) {
+#if IS31FL3731_I2C_PERSISTENCE > 0
+    for (uint8_t i = 0; i < IS31FL3731_I2C_PERSISTENCE; i++) {
+        if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + offset, driver_buffers[index].pwm_buffer + offset, length, IS31FL3731_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+    }
+#else
+    i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + offset, driver_buffers[index].pwm_buffer + offset, length, IS31FL3731_I2C_TIMEOUT);
+#endif
+}
+
+static inline bool is31fl3731_pwm_register_dirty(uint8_t index, uint8_t reg) {
+    return driver_buffers[index].pwm_buffer_dirty_registers[reg / 8] & (1 << (reg % 8));
+}
+
 void is31fl3731_write_pwm_buffer(uint8_t index) {
     // Assumes page 0 is already selected.
     // Transmit PWM registers in 9 transfers of 16 bytes.
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
     for (uint8_t i = 0; i < IS31FL3731_PWM_REGISTER_COUNT; i += 16) {
-#if IS31FL3731_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3731_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+        is31fl3731_write_pwm_registers(index, i, 16);
+    }
+}
+
+static void is31fl3731_write_pwm_buffer_dirty(uint8_t index) {
+    // Assumes page 0 is already selected.
+    // Transmit runs of dirty PWM registers, bridging small clean gaps between them.
+    uint8_t i = 0;
+    while (i < IS31FL3731_PWM_REGISTER_COUNT) {
+        if (!is31fl3731_pwm_register_dirty(index, i)) {
+            i++;
+            continue;
         }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, IS31FL3731_FRAME_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3731_I2C_TIMEOUT);
-#endif
+
+        uint8_t start = i;
+        uint8_t end   = i + 1; // one past the last dirty register of the run
+        for (uint8_t j = end; j < IS31FL3731_PWM_REGISTER_COUNT && j - start < IS31FL3731_PWM_BURST_LENGTH && j - end <= IS31FL3731_PWM_BURST_GAP; j++) {
+            if (is31fl3731_pwm_register_dirty(index, j)) {
+                end = j + 1;
+            }
+        }
+
+        is31fl3731_write_pwm_registers(index, start, end - start);
+        i = end;
     }
+
+    memset(driver_buffers[index].pwm_buffer_dirty_registers, 0, sizeof(driver_buffers[index].pwm_buffer_dirty_registers));
 }
 
 void is31fl3731_init_drivers(void) {
@@ -180,6 +223,8 @@ void is31fl3731_set_value(int index, uint8_t value) {
 
         driver_buffers[led.driver].pwm_buffer[led.v] = value;
         driver_buffers[led.driver].pwm_buffer_dirty  = true;
+
+        driver_buffers[led.driver].pwm_buffer_dirty_registers[led.v / 8] |= (1 << (led.v % 8));
     }
 }
 
@@ -207,7 +252,7 @@ void is31fl3731_set_led_control_register(uint8_t index, bool value) {
 
 void is31fl3731_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        is31fl3731_write_pwm_buffer(index);
+        is31fl3731_write_pwm_buffer_dirty(index);
 
         driver_buffers[index].pwm_buffer_dirty = false;
     }
@@ -28,6 +28,14 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_SLAVE_MATRIX_PUSH
+// target side, signal the initiator outside of a transaction
+// must be called with the split shared memory locked
+bool soft_serial_target_notify(void);
+// initiator side, returns whether the target signalled since the last call
+bool soft_serial_initiator_notified(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -42,6 +42,20 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// Each bank must start on a block boundary
+STATIC_ASSERT((WEAR_LEVELING_BANK_SIZE) % (EXTERNAL_FLASH_BLOCK_SIZE) == 0, "Half the backing size must be a multiple of EXTERNAL_FLASH_BLOCK_SIZE");
+
+bool backing_store_erase_step(uint32_t address, uint32_t end, uint32_t *next) {
+    bs_dprintf("Erase block at %d\n", (int)address);
+    if (address % (EXTERNAL_FLASH_BLOCK_SIZE) != 0 || address + (EXTERNAL_FLASH_BLOCK_SIZE) > end) {
+        return false;
+    }
+    *next = address + (EXTERNAL_FLASH_BLOCK_SIZE);
+    return flash_erase_block((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address) == FLASH_STATUS_SUCCESS;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -2,6 +2,7 @@
 """
 import bisect
 import dataclasses
+import math
 from typing import Optional
 
 from milc import cli
@@ -60,12 +61,42 @@ def _gen_led_config(info_data, config_type):
     lines.append(f'  {{ {", ".join(pos)} }},')
     lines.append(f'  {{ {", ".join(flags)} }},')
     lines.append('};')
+    lines.extend(_gen_splash_distances(led_layout, config_type))
     lines.append('#endif')
     lines.append('')
 
     return lines
 
 
+def _gen_splash_distances(led_layout, config_type):
+    """Convert info.json content to a table of distances between every pair of LEDs, used by the splash effects
+    """
+    if len(led_layout) < 2:
+        return []
+
+    points = [(led_data.get('x', 0), led_data.get('y', 0)) for led_data in led_layout]
+
+    lines = []
+    lines.append(f'#ifdef {config_type.upper()}_SPLASH_DISTANCE_TABLE')
+    lines.append('#include "progmem.h"')
+    lines.append(f'__attribute__ ((weak)) const uint8_t g_{config_type}_splash_distance[] PROGMEM = {{')
+
+    # Lower triangle, the distance between LEDs a > b is at a * (a - 1) / 2 + b
+    for a in range(1, len(points)):
+        distances = []
+        for b in range(a):
+            dx = points[a][0] - points[b][0]
+            dy = points[a][1] - points[b][1]
+            # Same truncation to 16 bits as sqrt16(dx * dx + dy * dy)
+            distances.append(str(math.isqrt((dx * dx + dy * dy) & 0xFFFF)))
+        lines.append(f'    {", ".join(distances)},')
+
+    lines.append('};')
+    lines.append('#endif')
+
+    return lines
+
+
 def _gen_matrix_mask(info_data):
     """Convert info.json content to matrix_mask
     """
@@ -136,6 +136,7 @@ class QFFUnicodeGlyphTableV1:
         self.header.length = len(self.glyphs.keys()) * 6
         self.header.write(fp)
 
+        # Sorted by code point, so that the table can be binary searched on-device
         for n in sorted(self.glyphs.keys()):
             self.glyphs[n].write(fp, True)
 
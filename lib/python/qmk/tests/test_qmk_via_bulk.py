@@ -0,0 +1,109 @@
+from collections import deque
+
+import pytest
+
+import qmk.via_bulk as vb
+
+
+class FakeKeyboard:
+    """Minimal device side of the protocol, answering like hidapi would.
+    """
+    def __init__(self, keymap):
+        self.keymap = bytes(keymap)
+        self.responses = deque()
+        self.staging = None
+
+    def write(self, data):
+        assert data[0] == 0 and len(data) == vb.PACKET_SIZE + 1
+        packet = bytearray(data[1:])
+        command = packet[1]
+
+        if command == vb.READ_BEGIN:
+            payload = vb.rle_encode(self.keymap) if packet[2] & vb.FLAG_RLE else self.keymap
+            self._reply(packet, 0, len(self.keymap) >> 8, len(self.keymap) & 0xFF)
+            chunk = vb.PACKET_SIZE - vb.HEADER_SIZE
+            sequence = 0
+            for sequence, offset in enumerate(range(0, len(payload), chunk)):
+                part = payload[offset:offset + chunk]
+                self.responses.append(bytes([vb.RAW_HID_ID, vb.READ_DATA, sequence, len(part), *part]).ljust(vb.PACKET_SIZE, b'\0'))
+            crc = vb.crc16(self.keymap)
+            self.responses.append(bytes([vb.RAW_HID_ID, vb.READ_END, 0, crc >> 8, crc & 0xFF, sequence + 1]).ljust(vb.PACKET_SIZE, b'\0'))
+        elif command == vb.WRITE_BEGIN:
+            self.flags = packet[2]
+            self.size = (packet[3] << 8) | packet[4]
+            self.staging = bytearray()
+            self._reply(packet, 0)
+        elif command == vb.WRITE_DATA:
+            self.staging += packet[vb.HEADER_SIZE:vb.HEADER_SIZE + packet[3]]
+        elif command == vb.WRITE_COMMIT:
+            data = vb.rle_decode(self.staging) if self.flags & vb.FLAG_RLE else bytes(self.staging)
+            if vb.crc16(data) != (packet[2] << 8) | packet[3]:
+                self._reply(packet, 0x05)
+            else:
+                self.keymap = data
+                self._reply(packet, 0)
+        else:
+            self._reply(packet, 0)
+
+    def read(self, size, timeout_ms):
+        return list(self.responses.popleft()) if self.responses else []
+
+    def _reply(self, packet, *fields):
+        packet[2:2 + len(fields)] = bytes(fields)
+        self.responses.append(bytes(packet))
+
+
+def keymap_with_transparent_layers(layers=8, keys=40):
+    keymap = bytearray()
+    for layer in range(layers):
+        for key in range(keys):
+            keycode = 0x04 + key if layer == 0 else 0x01
+            keymap += bytes([keycode >> 8, keycode & 0xFF])
+    return bytes(keymap)
+
+
+def test_crc16_check_value():
+    assert vb.crc16(b'123456789') == 0x29B1
+
+
+def test_rle_round_trip():
+    for data in [b'', bytes(2), keymap_with_transparent_layers(), bytes(range(256)), b'\x00\x01' * 300]:
+        assert vb.rle_decode(vb.rle_encode(data)) == data
+
+
+def test_rle_compresses_transparent_layers():
+    keymap = keymap_with_transparent_layers()
+    assert len(vb.rle_encode(keymap)) < len(keymap) // 4
+
+
+def test_rle_decode_rejects_truncated_data():
+    with pytest.raises(ValueError):
+        vb.rle_decode(b'\x01\x00\x04')
+
+
+@pytest.mark.parametrize('compress', [True, False])
+def test_read_keymap(compress):
+    keymap = keymap_with_transparent_layers()
+    client = vb.ViaBulkClient(FakeKeyboard(keymap))
+    assert client.read_keymap(compress=compress) == keymap
+
+
+@pytest.mark.parametrize('compress', [True, False])
+def test_write_keymap(compress):
+    keyboard = FakeKeyboard(bytes(640))
+    keymap = keymap_with_transparent_layers()
+    vb.ViaBulkClient(keyboard).write_keymap(keymap, compress=compress)
+    assert keyboard.keymap == keymap
+
+
+def test_write_keymap_reports_crc_mismatch():
+    class CorruptingKeyboard(FakeKeyboard):
+        def write(self, data):
+            if data[2] == vb.WRITE_DATA and data[3] == 0:
+                data = data[:-1] + bytes([data[-1] ^ 0xFF])
+            super().write(data)
+
+    keyboard = CorruptingKeyboard(bytes(640))
+    with pytest.raises(vb.ViaBulkError):
+        vb.ViaBulkClient(keyboard).write_keymap(keymap_with_transparent_layers(), compress=False)
+    assert keyboard.keymap == bytes(640)
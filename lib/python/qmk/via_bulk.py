@@ -0,0 +1,195 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Reference client for bulk dynamic keymap transfers over raw HID.
+# See quantum/via_bulk.h for the protocol.
+
+RAW_HID_ID = 0xB1
+PACKET_SIZE = 32
+HEADER_SIZE = 4
+
+READ_BEGIN = 0x01
+WRITE_BEGIN = 0x02
+WRITE_DATA = 0x03
+WRITE_COMMIT = 0x04
+ABORT = 0x05
+READ_DATA = 0x81
+READ_END = 0x82
+
+FLAG_RLE = 0x01
+
+STATUS_NAMES = {
+    0x00: 'ok',
+    0x01: 'invalid command',
+    0x02: 'invalid size',
+    0x03: 'sequence error',
+    0x04: 'encoding error',
+    0x05: 'CRC mismatch',
+}
+
+
+class ViaBulkError(Exception):
+    """Raised when the keyboard rejects or aborts a transfer.
+    """
+    def __init__(self, status, message=None):
+        self.status = status
+        super().__init__(message or STATUS_NAMES.get(status, f'status 0x{status:02X}'))
+
+
+def crc16(data, crc=0xFFFF):
+    """Computes the CRC-16/CCITT-FALSE used to verify transfers.
+
+    >>> hex(crc16(b'123456789'))
+    '0x29b1'
+    """
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def rle_encode(data):
+    """Run-length encodes a big-endian keycode buffer, as the keyboard does.
+
+    >>> rle_encode(bytes([0, 4, 0, 1, 0, 1, 0, 1])).hex()
+    '000004810001'
+    """
+    keycodes = [data[i:i + 2] for i in range(0, len(data), 2)]
+    out = bytearray()
+    pos = 0
+
+    while pos < len(keycodes):
+        run = 1
+        while pos + run < len(keycodes) and run < 129 and keycodes[pos + run] == keycodes[pos]:
+            run += 1
+
+        if run >= 2:
+            out.append(0x80 | (run - 2))
+            out += keycodes[pos]
+            pos += run
+            continue
+
+        # Stop the literal where the next run starts
+        literal = 1
+        while pos + literal < len(keycodes) and literal < 128:
+            if pos + literal + 1 < len(keycodes) and keycodes[pos + literal] == keycodes[pos + literal + 1]:
+                break
+            literal += 1
+
+        out.append(literal - 1)
+        for keycode in keycodes[pos:pos + literal]:
+            out += keycode
+        pos += literal
+
+    return bytes(out)
+
+
+def rle_decode(data):
+    """Expands a run-length encoded keycode buffer.
+    """
+    out = bytearray()
+    pos = 0
+
+    while pos < len(data):
+        token = data[pos]
+        pos += 1
+        if token & 0x80:
+            if pos + 2 > len(data):
+                raise ValueError('truncated run')
+            out += data[pos:pos + 2] * ((token & 0x7F) + 2)
+            pos += 2
+        else:
+            length = (token + 1) * 2
+            if pos + length > len(data):
+                raise ValueError('truncated literal')
+            out += data[pos:pos + length]
+            pos += length
+
+    return bytes(out)
+
+
+class ViaBulkClient:
+    """Reads and writes the whole dynamic keymap of a keyboard.
+
+    `device` is anything with hidapi's `write(data)` and `read(size, timeout_ms)` methods,
+    opened on the keyboard's raw HID interface.
+    """
+    def __init__(self, device, packet_size=PACKET_SIZE, timeout=1000):
+        self.device = device
+        self.packet_size = packet_size
+        self.timeout = timeout
+
+    def _send(self, *fields):
+        packet = bytes([RAW_HID_ID, *fields]).ljust(self.packet_size, b'\0')
+        # hidapi expects the report ID first, which raw HID doesn't use
+        self.device.write(b'\0' + packet)
+
+    def _receive(self, command):
+        while True:
+            packet = bytes(self.device.read(self.packet_size, self.timeout))
+            if not packet:
+                raise TimeoutError('no response from keyboard')
+            if packet[0] == RAW_HID_ID and packet[1] == command:
+                return packet
+
+    def _request(self, command, *fields):
+        self._send(command, *fields)
+        status = self._receive(command)[2]
+        if status:
+            raise ViaBulkError(status)
+
+    def abort(self):
+        self._send(ABORT)
+        self._receive(ABORT)
+
+    def read_keymap(self, compress=True):
+        """Streams the whole keymap, as laid out by dynamic_keymap_get_buffer().
+        """
+        self._send(READ_BEGIN, FLAG_RLE if compress else 0)
+        begin = self._receive(READ_BEGIN)
+        if begin[2]:
+            raise ViaBulkError(begin[2])
+        size = (begin[3] << 8) | begin[4]
+
+        payload = bytearray()
+        sequence = 0
+        while True:
+            packet = bytes(self.device.read(self.packet_size, self.timeout))
+            if not packet:
+                raise TimeoutError('read stream stalled')
+            if packet[0] != RAW_HID_ID:
+                continue
+
+            if packet[1] == READ_DATA:
+                if packet[2] != sequence:
+                    self.abort()
+                    raise ViaBulkError(0x03, f'expected packet {sequence}, got {packet[2]}')
+                payload += packet[HEADER_SIZE:HEADER_SIZE + packet[3]]
+                sequence = (sequence + 1) & 0xFF
+            elif packet[1] == READ_END:
+                if packet[2]:
+                    raise ViaBulkError(packet[2])
+                break
+
+        data = rle_decode(payload) if compress else bytes(payload)
+        if len(data) != size:
+            raise ViaBulkError(0x02, f'expected {size} bytes, got {len(data)}')
+        if crc16(data) != ((packet[3] << 8) | packet[4]):
+            raise ViaBulkError(0x05)
+        return data
+
+    def write_keymap(self, data, compress=True):
+        """Streams a whole keymap, which the keyboard only applies once it has been verified.
+        """
+        self._request(WRITE_BEGIN, FLAG_RLE if compress else 0, len(data) >> 8, len(data) & 0xFF)
+
+        payload = rle_encode(data) if compress else bytes(data)
+        chunk = self.packet_size - HEADER_SIZE
+        for sequence, offset in enumerate(range(0, len(payload), chunk)):
+            part = payload[offset:offset + chunk]
+            self._send(WRITE_DATA, sequence & 0xFF, len(part), *part)
+
+        crc = crc16(data)
+        self._request(WRITE_COMMIT, crc >> 8, crc & 0xFF)
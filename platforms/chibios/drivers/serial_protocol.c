@@ -10,6 +10,17 @@
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+/* Sent by the slave outside of transactions, never a valid handshake as
+ * transaction ids are limited to 0..127. */
+#    define SERIAL_NOTIFY_TOKEN 0xFF
+
+/* Start out notified, so that the master reads the initial slave state. */
+static bool target_notified = true;
+
+static inline void collect_notifications(void);
+#endif
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -100,10 +111,21 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+    /* Don't lose notifications that arrived since the last transaction. */
+    collect_notifications();
+#endif
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+    /* Pick up notifications sent while the queue was being cleared, later
+     * ones are caught while waiting for the handshake. */
+    collect_notifications();
+#endif
+
     return initiate_transaction((uint8_t)index);
 }
 
@@ -133,7 +155,23 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)))) {
+        serial_dprintf("SPLIT: receiving handshake failed\n");
+        return false;
+    }
+
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+    /* The slave may have notified us right before it saw the transaction. */
+    while (transaction_id_shake == SERIAL_NOTIFY_TOKEN) {
+        target_notified = true;
+        if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)))) {
+            serial_dprintf("SPLIT: receiving handshake failed\n");
+            return false;
+        }
+    }
+#endif
+
+    if (unlikely(transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
         return false;
     }
@@ -156,3 +194,41 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     return true;
 }
+
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+
+/**
+ * @brief Notify the master outside of a transaction. As the slave thread holds
+ * the shared memory lock for the whole of a transaction, holding it here keeps
+ * the token from ending up in the middle of one.
+ */
+bool soft_serial_target_notify(void) {
+    uint8_t token = SERIAL_NOTIFY_TOKEN;
+    return serial_transport_send(&token, sizeof(token));
+}
+
+/**
+ * @brief Pick up notifications the slave sent while no transaction was running.
+ */
+static inline void collect_notifications(void) {
+    uint8_t buffer[8];
+    size_t  received;
+
+    while ((received = serial_transport_receive_available(buffer, sizeof(buffer))) > 0) {
+        for (size_t i = 0; i < received; i++) {
+            if (buffer[i] == SERIAL_NOTIFY_TOKEN) {
+                target_notified = true;
+            }
+        }
+    }
+}
+
+bool soft_serial_initiator_notified(void) {
+    collect_notifications();
+
+    bool notified   = target_notified;
+    target_notified = false;
+    return notified;
+}
+
+#endif
@@ -40,6 +40,13 @@ bool __attribute__((nonnull, hot)) serial_transport_receive(uint8_t* destination
  */
 bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* destination, const size_t size);
 
+/**
+ * @brief Non-blocking receive of up to size * bytes that already arrived.
+ *
+ * @return size_t Number of bytes received.
+ */
+size_t __attribute__((nonnull)) serial_transport_receive_available(uint8_t* destination, const size_t size);
+
 /**
  * @brief Blocking send of buffer with timeout.
  *
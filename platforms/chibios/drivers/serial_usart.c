@@ -165,6 +165,10 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+inline size_t serial_transport_receive_available(uint8_t* destination, const size_t size) {
+    return chnReadTimeout(serial_driver, destination, size, TIME_IMMEDIATE);
+}
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
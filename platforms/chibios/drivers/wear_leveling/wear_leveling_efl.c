@@ -20,6 +20,9 @@ static flash_sector_t first_sector = UINT16_MAX;
 #endif // WEAR_LEVELING_EFL_OMIT_LAST_SECTOR_COUNT
 
 static flash_sector_t sector_count = UINT16_MAX;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+static flash_sector_t bank_sector = UINT16_MAX;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 static BaseFlash     *flash;
 static bool           flash_erased_is_one;
 static volatile bool  is_issuing_read    = false;
@@ -115,6 +118,19 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Banks are erased a sector at a time, so the second one needs to start on a sector boundary
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        if (flashGetSectorOffset(flash, first_sector + i) - base_offset == (WEAR_LEVELING_BANK_SIZE)) {
+            bank_sector = first_sector + i;
+            break;
+        }
+    }
+    if (bank_sector == UINT16_MAX) {
+        chSysHalt("Half the wear_leveling backing size does not fall on a sector boundary, as required for background consolidation");
+    }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     return true;
 }
 
@@ -148,6 +164,28 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+bool backing_store_erase_step(uint32_t address, uint32_t end, uint32_t *next) {
+    bs_dprintf("Erase sector at %d\n", (int)address);
+
+    // Sectors may vary in size, so find the one starting at the requested address. Both banks start on a sector
+    // boundary, as checked on init, so the sectors of one never overlap the other.
+    flash_sector_t sector = address < (WEAR_LEVELING_BANK_SIZE) ? first_sector : bank_sector;
+    while (flashGetSectorOffset(flash, sector) - base_offset < address) {
+        ++sector;
+    }
+    *next = address + flashGetSectorSize(flash, sector);
+
+    flash_error_t status = flashStartEraseSector(flash, sector);
+    if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+        return false;
+    }
+
+    status = flashWaitErase(flash);
+    return status == FLASH_NO_ERROR || status == FLASH_BUSY_ERASING;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
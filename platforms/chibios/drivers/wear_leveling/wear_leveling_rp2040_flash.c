@@ -190,6 +190,24 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+bool backing_store_erase_step(uint32_t address, uint32_t end, uint32_t *next) {
+    // Each bank must start on a sector boundary
+    STATIC_ASSERT((WEAR_LEVELING_BANK_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Half the backing size must be a multiple of FLASH_SECTOR_SIZE");
+
+    bs_dprintf("Erase sector at %d\n", (int)address);
+    if (address % (FLASH_SECTOR_SIZE) != 0 || address + (FLASH_SECTOR_SIZE) > end) {
+        return false;
+    }
+    *next = address + (FLASH_SECTOR_SIZE);
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + address, (FLASH_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    return true;
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
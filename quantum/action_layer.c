@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -335,16 +336,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch scan layers
  *
- * Gets the layer based on key info
+ * Walks the supplied layer state from the top down, returning the first layer with a non-transparent action for key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_scan_layers(layer_state_t layers, keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -356,6 +356,74 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if defined(LAYER_LOOKUP_CACHE_ENABLE) && !defined(NO_ACTION_LAYER)
+/** \brief layer lookup cache
+ *
+ * Resolved layer per matrix position, valid for the combined layer state it was filled in for.
+ * Entries are filled lazily on first lookup, so a layer change only costs clearing the valid bits.
+ */
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static uint8_t       layer_lookup_cache_valid[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)] = {0};
+static layer_state_t layer_lookup_cache_state                                                            = 0;
+
+/** \brief Layer lookup cache invalidate
+ *
+ * Drops all resolved entries, must be called whenever the keymap contents change
+ */
+void layer_lookup_cache_invalidate(void) {
+    memset(layer_lookup_cache_valid, 0, sizeof(layer_lookup_cache_valid));
+}
+
+/** \brief Layer lookup cache invalidate key
+ *
+ * Drops the resolved entry for a single matrix position
+ */
+void layer_lookup_cache_invalidate_key(uint8_t row, uint8_t col) {
+    if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+        const uint16_t entry_number = (uint16_t)(row * MATRIX_COLS) + col;
+        layer_lookup_cache_valid[entry_number / (CHAR_BIT)] &= ~(1U << (entry_number % (CHAR_BIT)));
+    }
+}
+
+/** \brief Layer lookup cache get layer
+ *
+ * Returns the resolved layer for a matrix position, scanning the layers only on a cache miss
+ */
+static uint8_t layer_lookup_cache_get_layer(layer_state_t layers, keypos_t key) {
+    // Layer state may also be written directly (e.g. split sync), so compare rather than rely on setters
+    if (layers != layer_lookup_cache_state) {
+        layer_lookup_cache_invalidate();
+        layer_lookup_cache_state = layers;
+    }
+
+    const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+    const uint16_t storage_idx  = entry_number / (CHAR_BIT);
+    const uint8_t  storage_bit  = entry_number % (CHAR_BIT);
+
+    if (!(layer_lookup_cache_valid[storage_idx] & (1U << storage_bit))) {
+        layer_lookup_cache[key.row][key.col] = layer_switch_scan_layers(layers, key);
+        layer_lookup_cache_valid[storage_idx] |= (1U << storage_bit);
+    }
+    return layer_lookup_cache[key.row][key.col];
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE_ENABLE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return layer_lookup_cache_get_layer(layers, key);
+    }
+#    endif
+    return layer_switch_scan_layers(layers, key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
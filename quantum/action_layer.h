@@ -166,6 +166,15 @@ uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+#if defined(LAYER_LOOKUP_CACHE_ENABLE) && !defined(NO_ACTION_LAYER)
+/* resolved layer lookup cache, must be invalidated whenever keymap contents change */
+void layer_lookup_cache_invalidate(void);
+void layer_lookup_cache_invalidate_key(uint8_t row, uint8_t col);
+#else
+#    define layer_lookup_cache_invalidate()
+#    define layer_lookup_cache_invalidate_key(row, col) ((void)(row), (void)(col))
+#endif
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -10,6 +11,10 @@
 #include "quantum_keycodes.h"
 #include "timer.h"
 #include "wait.h"
+#include "matrix.h"
+#include "debug.h"
+#include "util.h"
+#include "compiler_support.h"
 
 #ifndef NO_ACTION_TAPPING
 
@@ -127,17 +132,29 @@ static bool     flow_tap_expired      = true;
 static bool flow_tap_key_if_within_term(keyrecord_t *record, uint16_t prev_time);
 #    endif // defined(FLOW_TAP_TERM)
 
+STATIC_ASSERT(WAITING_BUFFER_SIZE >= 2 && WAITING_BUFFER_SIZE <= 256, "WAITING_BUFFER_SIZE must be between 2 and 256");
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// Per-key bitmaps of the presses and releases enqueued since the buffer was last empty, so that looking for a key's
+// counterpart event can usually skip scanning the buffer. Bits are only cleared once the buffer empties, so a set bit
+// may be stale, but a clear bit is always accurate. Events from outside the matrix (combos, encoders...) disable this.
+static matrix_row_t waiting_buffer_pressed[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_released[MATRIX_ROWS] = {};
+static bool         waiting_buffer_untracked             = false;
+
+static waiting_buffer_stats_t waiting_buffer_stats = {.size = WAITING_BUFFER_SIZE - 1};
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
 static void waiting_buffer_scan_tap(void);
+static bool waiting_buffer_may_contain(keypos_t key, bool pressed);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
@@ -163,6 +180,12 @@ void action_tapping_process(keyrecord_t record) {
         if (!waiting_buffer_enq(record)) {
             // clear all in case of overflow.
             ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+            uint16_t dropped = (waiting_buffer_head - waiting_buffer_tail + WAITING_BUFFER_SIZE) % WAITING_BUFFER_SIZE + 1;
+            if (waiting_buffer_stats.overflow_count < UINT16_MAX) {
+                waiting_buffer_stats.overflow_count++;
+            }
+            waiting_buffer_stats.dropped_count = MIN((uint32_t)waiting_buffer_stats.dropped_count + dropped, UINT16_MAX);
+            dprintf("waiting buffer overflow: %u events dropped (%u overflows, %u dropped in total)\n", dropped, waiting_buffer_stats.overflow_count, waiting_buffer_stats.dropped_count);
             clear_keyboard();
             waiting_buffer_clear();
             tapping_key = (keyrecord_t){0};
@@ -664,9 +687,26 @@ bool waiting_buffer_enq(keyrecord_t record) {
         return false;
     }
 
+    if (waiting_buffer_head == waiting_buffer_tail) {
+        // Empty, so nothing previously marked in the bitmaps is still queued
+        memset(waiting_buffer_pressed, 0, sizeof(waiting_buffer_pressed));
+        memset(waiting_buffer_released, 0, sizeof(waiting_buffer_released));
+        waiting_buffer_untracked = false;
+    }
+    if (record.event.key.row < MATRIX_ROWS && record.event.key.col < MATRIX_COLS) {
+        (record.event.pressed ? waiting_buffer_pressed : waiting_buffer_released)[record.event.key.row] |= MATRIX_ROW_SHIFTER << record.event.key.col;
+    } else {
+        waiting_buffer_untracked = true;
+    }
+
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
+    uint8_t used = (waiting_buffer_head - waiting_buffer_tail + WAITING_BUFFER_SIZE) % WAITING_BUFFER_SIZE;
+    if (used > waiting_buffer_stats.high_water) {
+        waiting_buffer_stats.high_water = used;
+    }
+
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
@@ -686,6 +726,9 @@ void waiting_buffer_clear(void) {
  * FIXME: Needs docs
  */
 bool waiting_buffer_typed(keyevent_t event) {
+    if (!waiting_buffer_may_contain(event.key, !event.pressed)) {
+        return false;
+    }
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
@@ -694,6 +737,47 @@ bool waiting_buffer_typed(keyevent_t event) {
     return false;
 }
 
+/** \brief Whether the waiting buffer may hold a press or release of `key`
+ *
+ * False is definite, true means the buffer needs to be scanned.
+ */
+static bool waiting_buffer_may_contain(keypos_t key, bool pressed) {
+    if (waiting_buffer_untracked || key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return true;
+    }
+    return (pressed ? waiting_buffer_pressed : waiting_buffer_released)[key.row] & (MATRIX_ROW_SHIFTER << key.col);
+}
+
+void waiting_buffer_get_stats(waiting_buffer_stats_t *stats) {
+    *stats = waiting_buffer_stats;
+}
+
+void waiting_buffer_reset_stats(void) {
+    waiting_buffer_stats = (waiting_buffer_stats_t){.size = WAITING_BUFFER_SIZE - 1};
+}
+
+bool waiting_buffer_raw_hid_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, flags/status, size, high_water, overflow_count, dropped_count ]
+    if (length < 8 || data[0] != WAITING_BUFFER_RAW_HID_ID) {
+        return false;
+    }
+
+    bool                   reset = data[1] & 0x01;
+    waiting_buffer_stats_t stats = waiting_buffer_stats;
+    if (reset) {
+        waiting_buffer_reset_stats();
+    }
+
+    data[1] = 0;
+    data[2] = stats.size;
+    data[3] = stats.high_water;
+    data[4] = stats.overflow_count & 0xFF;
+    data[5] = stats.overflow_count >> 8;
+    data[6] = stats.dropped_count & 0xFF;
+    data[7] = stats.dropped_count >> 8;
+    return true;
+}
+
 /** \brief Waiting buffer has anykey pressed
  *
  * FIXME: Needs docs
@@ -717,6 +801,10 @@ void waiting_buffer_scan_tap(void) {
         return;
     }
 
+    if (!waiting_buffer_may_contain(tapping_key.event.key, false)) {
+        return;
+    }
+
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
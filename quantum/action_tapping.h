@@ -32,12 +32,42 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of key events that can be held back while a tap-hold key is undecided, plus one */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
+
+/* raw HID command ID used to query waiting buffer statistics */
+#ifndef WAITING_BUFFER_RAW_HID_ID
+#    define WAITING_BUFFER_RAW_HID_ID 0xB2
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+
+typedef struct waiting_buffer_stats_t {
+    uint8_t  size;           // usable capacity, i.e. WAITING_BUFFER_SIZE - 1
+    uint8_t  high_water;     // most events held at once
+    uint16_t overflow_count; // times the buffer overflowed and all tapping state was cleared
+    uint16_t dropped_count;  // events lost to those overflows
+} waiting_buffer_stats_t;
+
+/** Gets the waiting buffer usage statistics collected since boot or the last reset. */
+void waiting_buffer_get_stats(waiting_buffer_stats_t *stats);
+void waiting_buffer_reset_stats(void);
+
+/**
+ * Handles a raw HID request for waiting buffer statistics.
+ *
+ * Request:  [ WAITING_BUFFER_RAW_HID_ID, flags ], flags bit 0 resets the statistics after reading.
+ * Response: [ WAITING_BUFFER_RAW_HID_ID, status, size, high_water, overflow_count, dropped_count ], counts as
+ * little-endian uint16_t, status is 0 on success.
+ *
+ * @return true if the packet was a waiting buffer request, and the response should be sent
+ */
+bool waiting_buffer_raw_hid_command(uint8_t *data, uint8_t length);
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
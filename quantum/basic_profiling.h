@@ -19,6 +19,9 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    For per-stage min/avg/max/p99 figures of the whole main loop, see SCAN_PROFILER_ENABLE
+    and scan_profiler.h instead.
 */
 
 #if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
@@ -23,11 +23,27 @@
 #define DEBOUNCE_ELAPSED 0
 
 #if DEBOUNCE > 0
+#    ifdef DEBOUNCE_SYM_DEFER_PK_PACKED
+// Counters are packed four to a 32-bit word so they can be updated a word at a time.
+// Each counter lane needs a spare top bit for the borrow-free subtraction, limiting the period to 127ms.
+#        if DEBOUNCE > 127
+#            error DEBOUNCE_SYM_DEFER_PK_PACKED supports a maximum DEBOUNCE of 127
+#        endif
+#        define COUNTER_WORDS_PER_ROW ((MATRIX_COLS + 3) / 4)
+#        define LANES_LOW 0x01010101UL
+#        define LANES_HIGH 0x80808080UL
+#        define LANES_VALUE 0x7F7F7F7FUL
+// Uses MATRIX_ROWS_PER_HAND instead of MATRIX_ROWS to support split keyboards
+static uint32_t debounce_counters[MATRIX_ROWS_PER_HAND][COUNTER_WORDS_PER_ROW] = {{DEBOUNCE_ELAPSED}};
+// Rows with at least one counter in flight
+static uint8_t active_rows[(MATRIX_ROWS_PER_HAND + 7) / 8] = {0};
+#    else
 typedef uint8_t debounce_counter_t;
 // Uses MATRIX_ROWS_PER_HAND instead of MATRIX_ROWS to support split keyboards
 static debounce_counter_t debounce_counters[MATRIX_ROWS_PER_HAND * MATRIX_COLS] = {DEBOUNCE_ELAPSED};
-static bool               counters_need_update;
-static bool               cooked_changed;
+#    endif
+static bool counters_need_update;
+static bool cooked_changed;
 
 static inline void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time);
 static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[]);
@@ -63,6 +79,7 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
     return cooked_changed;
 }
 
+#    ifndef DEBOUNCE_SYM_DEFER_PK_PACKED
 /**
  * @brief Updates debounce counters and transfers debounced key states if the debounce period has expired.
  *
@@ -127,6 +144,123 @@ static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cook
         }
     }
 }
+#    else
+/**
+ * @brief Returns a word with the top bit of each non-zero counter lane set.
+ */
+static inline uint32_t nonzero_lanes(uint32_t word) {
+    return (((word & LANES_VALUE) + LANES_VALUE) | word) & LANES_HIGH;
+}
+
+/**
+ * @brief Expands four column bits into a word with the matching counter lanes set to 0xFF.
+ */
+static inline uint32_t expand_lanes(matrix_row_t cols) {
+    return (((uint32_t)(cols & 0xF) * 0x00204081UL) & LANES_LOW) * 0xFF;
+}
+
+static inline bool row_is_active(uint8_t row) {
+    return active_rows[row / 8] & (1 << (row % 8));
+}
+
+static inline void set_row_active(uint8_t row, bool active) {
+    if (active) {
+        active_rows[row / 8] |= (1 << (row % 8));
+    } else {
+        active_rows[row / 8] &= ~(1 << (row % 8));
+    }
+}
+
+/**
+ * @brief Updates debounce counters and transfers debounced key states if the debounce period has expired.
+ *
+ * Only rows with counters in flight are visited, and their counters are decremented four at a time
+ * with a saturating subtraction. Keys whose counter reaches zero have their debounced state updated
+ * to match the raw state.
+ *
+ * @param raw The current raw key state matrix.
+ * @param cooked The debounced key state matrix to be updated.
+ * @param elapsed_time The time elapsed since the last debounce update, in milliseconds.
+ */
+static inline void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time) {
+    // Every counter is at most 127, so clamping keeps the lanes borrow-free without changing the result
+    const uint32_t elapsed = MIN(elapsed_time, 127) * LANES_LOW;
+
+    counters_need_update = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        if (!row_is_active(row)) {
+            continue;
+        }
+
+        matrix_row_t expired  = 0;
+        uint32_t     inflight = 0;
+        for (uint8_t word = 0; word < COUNTER_WORDS_PER_ROW; word++) {
+            uint32_t counters = debounce_counters[row][word];
+            if (counters == DEBOUNCE_ELAPSED) {
+                continue;
+            }
+
+            // Each lane becomes 128 + counter - elapsed, the top bit is kept only where counter >= elapsed
+            uint32_t lanes     = (counters | LANES_HIGH) - elapsed;
+            uint32_t remaining = lanes & LANES_VALUE & (((lanes & LANES_HIGH) >> 7) * 0xFF);
+            uint32_t finished  = nonzero_lanes(counters) & ~nonzero_lanes(remaining);
+
+            for (uint8_t lane = 0; finished; lane++, finished >>= 8) {
+                if (finished & 0x80) {
+                    expired |= MATRIX_ROW_SHIFTER << (word * 4 + lane);
+                }
+            }
+
+            debounce_counters[row][word] = remaining;
+            inflight |= remaining;
+        }
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+
+        set_row_active(row, inflight);
+        counters_need_update |= inflight;
+    }
+}
+
+/**
+ * @brief Initializes debounce counters for keys with changed states.
+ *
+ * Counters of keys that now match their debounced state are cleared, and keys with a changed state
+ * and no counter in flight get a fresh debounce period. Unchanged rows without counters are skipped.
+ *
+ * @param raw The current raw key state matrix.
+ * @param cooked The debounced key state matrix.
+ */
+static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[]) {
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+
+        if (!delta && !row_is_active(row)) {
+            continue;
+        }
+
+        uint32_t inflight = 0;
+        for (uint8_t word = 0; word < COUNTER_WORDS_PER_ROW; word++) {
+            uint32_t changed  = expand_lanes(delta >> (word * 4));
+            uint32_t counters = debounce_counters[row][word] & changed;
+            uint32_t idle     = changed & ~((nonzero_lanes(counters) >> 7) * 0xFF);
+
+            counters |= idle & (DEBOUNCE * LANES_LOW);
+            if (idle) {
+                counters_need_update = true;
+            }
+
+            debounce_counters[row][word] = counters;
+            inflight |= counters;
+        }
+        set_row_active(row, inflight);
+    }
+}
+#    endif
 
 #else
 #    include "none.c"
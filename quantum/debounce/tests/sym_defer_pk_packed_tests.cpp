@@ -0,0 +1,99 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <random>
+
+extern "C" {
+#include "debounce.h"
+#include "matrix.h"
+#include "timer.h"
+
+bool debounce_reference(matrix_row_t raw[], matrix_row_t cooked[], bool changed);
+void debounce_init_reference(void);
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class DebouncePackedEquivalence : public ::testing::Test {
+   protected:
+    std::mt19937 rng{0x44424E43};
+
+    matrix_row_t raw_[MATRIX_ROWS]              = {0};
+    matrix_row_t cooked_reference_[MATRIX_ROWS] = {0};
+    matrix_row_t cooked_packed_[MATRIX_ROWS]    = {0};
+
+    void SetUp() override {
+        debounce_init();
+        debounce_init_reference();
+        set_time(1234);
+    }
+
+    /* Flip each key with the given probability (in 1/1000ths), returning whether anything changed. */
+    bool chatter(unsigned permille) {
+        std::uniform_int_distribution<unsigned> dist(0, 999);
+        bool                                    changed = false;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (dist(rng) < permille) {
+                    raw_[row] ^= MATRIX_ROW_SHIFTER << col;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    void step(bool changed) {
+        bool reference_changed = debounce_reference(raw_, cooked_reference_, changed);
+        bool packed_changed    = debounce(raw_, cooked_packed_, changed);
+
+        ASSERT_EQ(reference_changed, packed_changed) << "at time " << timer_read_fast();
+        ASSERT_EQ(0, memcmp(cooked_reference_, cooked_packed_, sizeof(cooked_packed_))) << "at time " << timer_read_fast();
+    }
+
+    /* Release everything and let both implementations settle. */
+    void settle() {
+        memset(raw_, 0, sizeof(raw_));
+        step(true);
+        for (int i = 0; i < 300; i++) {
+            advance_time(1);
+            step(false);
+        }
+    }
+};
+
+TEST_F(DebouncePackedEquivalence, RandomChatter) {
+    std::uniform_int_distribution<unsigned> gap(0, 7);
+
+    for (int i = 0; i < 20000; i++) {
+        bool changed = chatter(i % 500 < 250 ? 5 : 0);
+        step(changed);
+        advance_time(gap(rng));
+        if (HasFatalFailure()) return;
+    }
+    settle();
+}
+
+TEST_F(DebouncePackedEquivalence, LongGaps) {
+    std::uniform_int_distribution<unsigned> gap(0, 400);
+
+    for (int i = 0; i < 2000; i++) {
+        step(chatter(20));
+        advance_time(gap(rng));
+        if (HasFatalFailure()) return;
+    }
+    settle();
+}
+
+TEST_F(DebouncePackedEquivalence, MostlyIdle) {
+    /* Mostly idle typing with a few bouncing keys in flight, one scan per millisecond */
+    for (int i = 0; i < 50000; i++) {
+        step(chatter(1));
+        advance_time(1);
+        if (HasFatalFailure()) return;
+    }
+    settle();
+}
@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Builds the unpacked sym_defer_pk algorithm under different names, so the packed
+// variant can be checked against it within the same test binary.
+
+#undef DEBOUNCE_SYM_DEFER_PK_PACKED
+#define debounce debounce_reference
+#define debounce_init debounce_init_reference
+
+#include "../sym_defer_pk.c"
@@ -60,6 +60,14 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms);
  */
 bool cancel_deferred_exec(deferred_token token);
 
+/**
+ * Gets the time at which the next deferred execution is due, so that callers can tell how long they may sleep for.
+ *
+ * @param trigger_time[out] the trigger time of the soonest deferred execution -- equivalent time-space as timer_read32()
+ * @return true if there is a pending deferred execution, otherwise false and trigger_time is left untouched
+ */
+bool deferred_exec_next_trigger(uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any deferred executors. Should not be invoked by keyboard/user code.
  */
@@ -110,9 +118,20 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Gets the time at which the next deferred execution in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the trigger time of the soonest deferred execution -- equivalent time-space as timer_read32()
+ * @return true if there is a pending deferred execution, otherwise false and trigger_time is left untouched
+ */
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
+ * Due executors are invoked soonest first, and only the soonest is checked when nothing is due.
  *
  * @param table[in] the custom table used for storage
  * @param table_count[in] the number of available items in the table
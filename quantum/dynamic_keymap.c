@@ -18,10 +18,16 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "send_string.h"
 #include "keycodes.h"
 #include "nvm_dynamic_keymap.h"
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    include <string.h>
+#    include "timer.h"
+#endif
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #else
@@ -36,27 +42,153 @@ uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+#    define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+// RAM copy of the dynamic keymap, so that keycode lookups never touch the NVM driver.
+// Edits are applied here straight away and written back once they stop for DYNAMIC_KEYMAP_WRITE_BACK_DELAY.
+static uint16_t dynamic_keymap_mirror[DYNAMIC_KEYMAP_KEY_COUNT];
+static uint8_t  dynamic_keymap_dirty[(DYNAMIC_KEYMAP_KEY_COUNT + 7) / 8];
+#    ifdef ENCODER_MAP_ENABLE
+static uint16_t dynamic_keymap_encoder_mirror[DYNAMIC_KEYMAP_LAYER_COUNT][NUM_ENCODERS][2];
+static bool     dynamic_keymap_encoder_dirty = false;
+#    endif // ENCODER_MAP_ENABLE
+static bool     dynamic_keymap_mirror_loaded = false;
+static bool     dynamic_keymap_pending       = false;
+static uint16_t dynamic_keymap_last_edit     = 0;
+
+static inline uint16_t dynamic_keymap_index(uint8_t layer, uint8_t row, uint8_t column) {
+    return ((uint16_t)layer * MATRIX_ROWS + row) * MATRIX_COLS + column;
+}
+
+static void dynamic_keymap_mirror_load(void) {
+    // Loaded on first use rather than at init, so that an eeconfig reset during boot is always seen
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                dynamic_keymap_mirror[dynamic_keymap_index(layer, row, column)] = nvm_dynamic_keymap_read_keycode(layer, row, column);
+            }
+        }
+#    ifdef ENCODER_MAP_ENABLE
+        for (uint8_t encoder = 0; encoder < NUM_ENCODERS; encoder++) {
+            dynamic_keymap_encoder_mirror[layer][encoder][0] = nvm_dynamic_keymap_read_encoder(layer, encoder, true);
+            dynamic_keymap_encoder_mirror[layer][encoder][1] = nvm_dynamic_keymap_read_encoder(layer, encoder, false);
+        }
+#    endif // ENCODER_MAP_ENABLE
+    }
+    dynamic_keymap_mirror_loaded = true;
+}
+
+static inline void dynamic_keymap_mirror_ensure_loaded(void) {
+    if (!dynamic_keymap_mirror_loaded) {
+        dynamic_keymap_mirror_load();
+    }
+}
+
+static inline void dynamic_keymap_mark_pending(void) {
+    dynamic_keymap_pending   = true;
+    dynamic_keymap_last_edit = timer_read();
+}
+
+static void dynamic_keymap_mirror_set(uint16_t index, uint16_t keycode) {
+    if (dynamic_keymap_mirror[index] != keycode) {
+        dynamic_keymap_mirror[index] = keycode;
+        dynamic_keymap_dirty[index / 8] |= 1 << (index % 8);
+        dynamic_keymap_mark_pending();
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
+void dynamic_keymap_flush(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (!dynamic_keymap_pending) {
+        return;
+    }
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                uint16_t index = dynamic_keymap_index(layer, row, column);
+                if (dynamic_keymap_dirty[index / 8] & (1 << (index % 8))) {
+                    nvm_dynamic_keymap_update_keycode(layer, row, column, dynamic_keymap_mirror[index]);
+                }
+            }
+        }
+    }
+    memset(dynamic_keymap_dirty, 0, sizeof(dynamic_keymap_dirty));
+#    ifdef ENCODER_MAP_ENABLE
+    if (dynamic_keymap_encoder_dirty) {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            for (uint8_t encoder = 0; encoder < NUM_ENCODERS; encoder++) {
+                nvm_dynamic_keymap_update_encoder(layer, encoder, true, dynamic_keymap_encoder_mirror[layer][encoder][0]);
+                nvm_dynamic_keymap_update_encoder(layer, encoder, false, dynamic_keymap_encoder_mirror[layer][encoder][1]);
+            }
+        }
+        dynamic_keymap_encoder_dirty = false;
+    }
+#    endif // ENCODER_MAP_ENABLE
+    dynamic_keymap_pending = false;
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+}
+
+void dynamic_keymap_task(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (dynamic_keymap_pending && timer_elapsed(dynamic_keymap_last_edit) >= DYNAMIC_KEYMAP_WRITE_BACK_DELAY) {
+        dynamic_keymap_flush();
+    }
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+}
+
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+    dynamic_keymap_mirror_ensure_loaded();
+    return dynamic_keymap_mirror[dynamic_keymap_index(layer, row, column)];
+#else
     return nvm_dynamic_keymap_read_keycode(layer, row, column);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+    dynamic_keymap_mirror_ensure_loaded();
+    dynamic_keymap_mirror_set(dynamic_keymap_index(layer, row, column), keycode);
+#else
     nvm_dynamic_keymap_update_keycode(layer, row, column, keycode);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+    layer_lookup_cache_invalidate_key(row, column);
 }
 
 #ifdef ENCODER_MAP_ENABLE
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+    dynamic_keymap_mirror_ensure_loaded();
+    return dynamic_keymap_encoder_mirror[layer][encoder_id][clockwise ? 0 : 1];
+#    else
     return nvm_dynamic_keymap_read_encoder(layer, encoder_id, clockwise);
+#    endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
+    dynamic_keymap_mirror_ensure_loaded();
+    if (dynamic_keymap_encoder_mirror[layer][encoder_id][clockwise ? 0 : 1] != keycode) {
+        dynamic_keymap_encoder_mirror[layer][encoder_id][clockwise ? 0 : 1] = keycode;
+        dynamic_keymap_encoder_dirty                                        = true;
+        dynamic_keymap_mark_pending();
+    }
+#    else
     nvm_dynamic_keymap_update_encoder(layer, encoder_id, clockwise, keycode);
+#    endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 #endif // ENCODER_MAP_ENABLE
 
 void dynamic_keymap_reset(void) {
     // Erase the keymaps, if necessary.
     nvm_dynamic_keymap_erase();
+    layer_lookup_cache_invalidate();
 
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
@@ -72,14 +204,51 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The erase may have left anything behind, so write every key back, and do so right away
+    memset(dynamic_keymap_dirty, 0xFF, sizeof(dynamic_keymap_dirty));
+#    ifdef ENCODER_MAP_ENABLE
+    dynamic_keymap_encoder_dirty = true;
+#    endif // ENCODER_MAP_ENABLE
+    dynamic_keymap_pending = true;
+    dynamic_keymap_flush();
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_ensure_loaded();
+    for (uint16_t i = 0; i < size; i++) {
+        uint32_t byte = (uint32_t)offset + i;
+        if (byte < DYNAMIC_KEYMAP_KEY_COUNT * 2) {
+            // Big endian, same as the EEPROM layout
+            uint16_t keycode = dynamic_keymap_mirror[byte / 2];
+            data[i]          = (byte & 1) ? (keycode & 0xFF) : (keycode >> 8);
+        } else {
+            data[i] = 0x00;
+        }
+    }
+#else
     nvm_dynamic_keymap_read_buffer(offset, size, data);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_mirror_ensure_loaded();
+    for (uint16_t i = 0; i < size; i++) {
+        uint32_t byte = (uint32_t)offset + i;
+        if (byte < DYNAMIC_KEYMAP_KEY_COUNT * 2) {
+            uint16_t keycode = dynamic_keymap_mirror[byte / 2];
+            keycode          = (byte & 1) ? ((keycode & 0xFF00) | data[i]) : ((keycode & 0x00FF) | ((uint16_t)data[i] << 8));
+            dynamic_keymap_mirror_set(byte / 2, keycode);
+        }
+    }
+#else
     nvm_dynamic_keymap_update_buffer(offset, size, data);
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+    layer_lookup_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -111,6 +280,10 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // A macro being typed out is read from the buffer as it goes
+    send_string_async_cancel();
+#endif
     nvm_dynamic_keymap_macro_update_buffer(offset, size, data);
 }
 
@@ -132,6 +305,9 @@ char send_string_get_next_nvm(void *arg) {
 }
 
 void dynamic_keymap_macro_reset(void) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_cancel();
+#endif
     // Erase the macros, if necessary.
     nvm_dynamic_keymap_macro_erase();
     nvm_dynamic_keymap_macro_reset();
@@ -166,6 +342,18 @@ void dynamic_keymap_macro_send(uint8_t id) {
         ++offset;
     }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Macros are read from the buffer as they are typed out, so the state has to outlive this call. Each queued macro
+    // keeps its own state; with one more than can be queued, the next one is never still in use.
+    static send_string_nvm_state_t states[SEND_STRING_ASYNC_MAX_STRINGS + 1];
+    static uint8_t                 current = 0;
+    uint8_t                        next    = (current + 1) % (SEND_STRING_ASYNC_MAX_STRINGS + 1);
+    states[next].offset                    = offset;
+    if (send_string_with_delay_async_stream(send_string_get_next_nvm, &states[next], DYNAMIC_KEYMAP_MACRO_DELAY)) {
+        current = next;
+    }
+#else
     send_string_nvm_state_t state = {.offset = offset};
     send_string_with_delay_impl(send_string_get_next_nvm, &state, DYNAMIC_KEYMAP_MACRO_DELAY);
+#endif
 }
@@ -26,6 +26,10 @@
 #    define DYNAMIC_KEYMAP_MACRO_COUNT 16
 #endif
 
+#ifndef DYNAMIC_KEYMAP_WRITE_BACK_DELAY
+#    define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 1000
+#endif
+
 uint8_t  dynamic_keymap_get_layer_count(void);
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
 void     dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode);
@@ -34,6 +38,11 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+// With DYNAMIC_KEYMAP_RAM_MIRROR, keymap edits are held in RAM and written back to EEPROM
+// once no further edits have been made for DYNAMIC_KEYMAP_WRITE_BACK_DELAY milliseconds.
+// dynamic_keymap_flush() writes back any pending edits immediately.
+void dynamic_keymap_flush(void);
+void dynamic_keymap_task(void);
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -39,6 +39,10 @@
 #    include "connection.h"
 #endif // CONNECTION_ENABLE
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_PERSIST)
+#    include "nvm_dynamic_macro.h"
+#endif // DYNAMIC_MACRO_ENABLE && DYNAMIC_MACRO_PERSIST
+
 #ifdef VIA_ENABLE
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -157,6 +161,10 @@ void eeconfig_init_quantum(void) {
     dynamic_keymap_reset();
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_PERSIST)
+    nvm_dynamic_macro_erase();
+#endif // DYNAMIC_MACRO_ENABLE && DYNAMIC_MACRO_PERSIST
+
     eeconfig_init_kb();
 
 #ifdef RGB_MATRIX_ENABLE
@@ -181,6 +189,14 @@ void eeconfig_disable(void) {
     nvm_eeconfig_disable();
 }
 
+void eeconfig_flush(void) {
+    nvm_eeconfig_flush();
+}
+
+void eeconfig_task(void) {
+    nvm_eeconfig_task();
+}
+
 bool eeconfig_is_enabled(void) {
     bool is_eeprom_enabled = nvm_eeconfig_is_enabled();
 #ifdef VIA_ENABLE
@@ -36,6 +36,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define EECONFIG_USER_DATA_VERSION (EECONFIG_USER_DATA_SIZE)
 #endif
 
+#ifndef EECONFIG_WRITE_BEHIND_DELAY
+#    define EECONFIG_WRITE_BEHIND_DELAY 2000
+#endif
+
 /* debug bit */
 #define EECONFIG_DEBUG_ENABLE (1 << 0)
 #define EECONFIG_DEBUG_MATRIX (1 << 1)
@@ -63,6 +67,12 @@ void eeconfig_init_user(void);
 void eeconfig_enable(void);
 void eeconfig_disable(void);
 
+// With EECONFIG_WRITE_BEHIND, updates are held in RAM and written to EEPROM once no further
+// updates have been made for EECONFIG_WRITE_BEHIND_DELAY milliseconds.
+// eeconfig_flush() writes any pending updates immediately.
+void eeconfig_flush(void);
+void eeconfig_task(void);
+
 typedef union debug_config_t debug_config_t;
 void                         eeconfig_read_debug(debug_config_t *debug_config) __attribute__((nonnull));
 void                         eeconfig_update_debug(const debug_config_t *debug_config) __attribute__((nonnull));
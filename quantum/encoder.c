@@ -4,6 +4,7 @@
 #include <string.h>
 #include "action.h"
 #include "encoder.h"
+#include "timer.h"
 #include "wait.h"
 
 #ifndef ENCODER_MAP_KEY_DELAY
@@ -17,14 +18,106 @@ __attribute__((weak)) bool should_process_encoder(void) {
 static encoder_events_t encoder_events;
 static bool             signal_queue_drain = false;
 
+#ifdef ENCODER_AGGREGATE_EVENTS
+typedef struct encoder_batch_t {
+    int8_t   pending; // detents still to be emitted, positive for clockwise
+    bool     pressed;
+    bool     clockwise;
+    uint32_t timer; // when the last event was emitted
+} encoder_batch_t;
+
+static encoder_batch_t encoder_batches[NUM_ENCODERS];
+
+#    ifdef ENCODER_MAP_ENABLE
+#        define ENCODER_BATCH_INTERVAL ENCODER_MAP_KEY_DELAY
+#    else
+#        define ENCODER_BATCH_INTERVAL ENCODER_AGGREGATE_INTERVAL
+#    endif
+
+static void encoder_batch_init(void) {
+    memset(encoder_batches, 0, sizeof(encoder_batches));
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        // Allow the first detent through straight away
+        encoder_batches[i].timer = timer_read32() - ENCODER_BATCH_INTERVAL;
+    }
+}
+
+static void encoder_batch_add(uint8_t index, bool clockwise) {
+    if (index >= NUM_ENCODERS) {
+        return;
+    }
+    // Turning back cancels out detents that haven't been emitted yet
+    int8_t *pending = &encoder_batches[index].pending;
+    if (clockwise && *pending < INT8_MAX) {
+        (*pending)++;
+    } else if (!clockwise && *pending > -INT8_MAX) {
+        (*pending)--;
+    }
+}
+
+#    ifdef ENCODER_MAP_ENABLE
+// Taps the encoder's key once per pending detent, holding and releasing each for ENCODER_MAP_KEY_DELAY without blocking
+static bool encoder_batch_emit(uint8_t index) {
+    encoder_batch_t *batch   = &encoder_batches[index];
+    bool             changed = false;
+    while ((batch->pressed || batch->pending != 0) && timer_elapsed32(batch->timer) >= ENCODER_MAP_KEY_DELAY) {
+        if (!batch->pressed) {
+            batch->clockwise = batch->pending > 0;
+            batch->pending += batch->clockwise ? -1 : 1;
+        }
+        batch->pressed = !batch->pressed;
+        batch->timer   = timer_read32();
+        action_exec(batch->clockwise ? MAKE_ENCODER_CW_EVENT(index, batch->pressed) : MAKE_ENCODER_CCW_EVENT(index, batch->pressed));
+        changed = true;
+    }
+    return changed;
+}
+
+// Releases the encoder's key if a tap is in progress, so it isn't left held when pending detents are dropped
+static void encoder_batch_release(uint8_t index) {
+    encoder_batch_t *batch = &encoder_batches[index];
+    if (batch->pressed) {
+        batch->pressed = false;
+        batch->timer   = timer_read32();
+        action_exec(batch->clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+    }
+}
+#    else  // ENCODER_MAP_ENABLE
+// Hands all pending detents to the callbacks at once, at most every ENCODER_AGGREGATE_INTERVAL
+static bool encoder_batch_emit(uint8_t index) {
+    encoder_batch_t *batch = &encoder_batches[index];
+    if (batch->pending == 0 || timer_elapsed32(batch->timer) < ENCODER_AGGREGATE_INTERVAL) {
+        return false;
+    }
+    bool    clockwise = batch->pending > 0;
+    uint8_t count     = clockwise ? batch->pending : -batch->pending;
+    batch->pending    = 0;
+    batch->timer      = timer_read32();
+    encoder_update_batch_kb(index, clockwise, count);
+    return true;
+}
+#    endif // ENCODER_MAP_ENABLE
+#endif     // ENCODER_AGGREGATE_EVENTS
+
 void encoder_init(void) {
     memset(&encoder_events, 0, sizeof(encoder_events));
+#ifdef ENCODER_AGGREGATE_EVENTS
+    encoder_batch_init();
+#endif // ENCODER_AGGREGATE_EVENTS
     encoder_driver_init();
 }
 
 static void encoder_queue_drain(void) {
     encoder_events.tail     = encoder_events.head;
     encoder_events.dequeued = encoder_events.enqueued;
+#ifdef ENCODER_AGGREGATE_EVENTS
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+#    ifdef ENCODER_MAP_ENABLE
+        encoder_batch_release(i);
+#    endif // ENCODER_MAP_ENABLE
+        encoder_batches[i].pending = 0;
+    }
+#endif // ENCODER_AGGREGATE_EVENTS
 }
 
 static bool encoder_handle_queue(void) {
@@ -32,7 +125,11 @@ static bool encoder_handle_queue(void) {
     uint8_t index;
     bool    clockwise;
     while (encoder_dequeue_event(&index, &clockwise)) {
-#ifdef ENCODER_MAP_ENABLE
+#if defined(ENCODER_AGGREGATE_EVENTS)
+
+        encoder_batch_add(index, clockwise);
+
+#elif defined(ENCODER_MAP_ENABLE)
 
         // The delays below cater for Windows and its wonderful requirements.
         action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
@@ -53,6 +150,11 @@ static bool encoder_handle_queue(void) {
 
         changed = true;
     }
+#ifdef ENCODER_AGGREGATE_EVENTS
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        changed |= encoder_batch_emit(i);
+    }
+#endif // ENCODER_AGGREGATE_EVENTS
     return changed;
 }
 
@@ -148,6 +250,22 @@ void encoder_signal_queue_drain(void) {
     signal_queue_drain = true;
 }
 
+#if defined(ENCODER_AGGREGATE_EVENTS) && !defined(ENCODER_MAP_ENABLE)
+__attribute__((weak)) bool encoder_update_batch_user(uint8_t index, bool clockwise, uint8_t count) {
+    return true;
+}
+
+__attribute__((weak)) bool encoder_update_batch_kb(uint8_t index, bool clockwise, uint8_t count) {
+    bool res = encoder_update_batch_user(index, clockwise, count);
+    if (res) {
+        for (uint8_t i = 0; i < count; i++) {
+            encoder_update_kb(index, clockwise);
+        }
+    }
+    return res;
+}
+#endif // defined(ENCODER_AGGREGATE_EVENTS) && !defined(ENCODER_MAP_ENABLE)
+
 __attribute__((weak)) bool encoder_update_user(uint8_t index, bool clockwise) {
     return true;
 }
@@ -49,6 +49,16 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+#    ifdef ENCODER_AGGREGATE_EVENTS
+#        ifndef ENCODER_AGGREGATE_INTERVAL
+#            define ENCODER_AGGREGATE_INTERVAL 10
+#        endif // ENCODER_AGGREGATE_INTERVAL
+
+// Called with `count` consecutive detents in the same direction, instead of once per detent
+bool encoder_update_batch_kb(uint8_t index, bool clockwise, uint8_t count);
+bool encoder_update_batch_user(uint8_t index, bool clockwise, uint8_t count);
+#    endif // ENCODER_AGGREGATE_EVENTS
+
 #    ifdef SPLIT_KEYBOARD
 
 #        if defined(ENCODER_A_PINS_RIGHT)
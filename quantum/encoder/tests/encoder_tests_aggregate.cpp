@@ -0,0 +1,132 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "timer.h"
+#include "encoder/tests/mock.h"
+
+void timer_clear(void);
+void advance_time(uint32_t ms);
+}
+
+struct batch {
+    uint8_t index;
+    bool    clockwise;
+    uint8_t count;
+};
+
+std::vector<batch> batches;
+int                detents_cw  = 0;
+int                detents_ccw = 0;
+bool               batch_user_result;
+
+bool encoder_update_batch_user(uint8_t index, bool clockwise, uint8_t count) {
+    batches.push_back({index, clockwise, count});
+    return batch_user_result;
+}
+
+bool encoder_update_kb(uint8_t index, bool clockwise) {
+    if (clockwise) {
+        detents_cw++;
+    } else {
+        detents_ccw++;
+    }
+    return true;
+}
+
+bool setAndRead(pin_t pin, bool val) {
+    setPin(pin, val);
+    return encoder_task();
+}
+
+void turnClockwise(int detents) {
+    for (int i = 0; i < detents; i++) {
+        setAndRead(0, false);
+        setAndRead(1, false);
+        setAndRead(0, true);
+        setAndRead(1, true);
+    }
+}
+
+void turnCounterClockwise(int detents) {
+    for (int i = 0; i < detents; i++) {
+        setAndRead(1, false);
+        setAndRead(0, false);
+        setAndRead(1, true);
+        setAndRead(0, true);
+    }
+}
+
+class EncoderAggregateTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        batches.clear();
+        detents_cw        = 0;
+        detents_ccw       = 0;
+        batch_user_result = false;
+        timer_clear();
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderAggregateTest, TestOneClockwise) {
+    turnClockwise(1);
+
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0].index, 0);
+    EXPECT_EQ(batches[0].clockwise, true);
+    EXPECT_EQ(batches[0].count, 1);
+}
+
+TEST_F(EncoderAggregateTest, TestBurstIsBatched) {
+    uint32_t start = timer_read32();
+    turnClockwise(60);
+
+    // The first detent goes straight out, the rest wait for the next interval
+    EXPECT_EQ(timer_read32(), start);
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches[0].count, 1);
+
+    advance_time(ENCODER_AGGREGATE_INTERVAL);
+    encoder_task();
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[1].index, 0);
+    EXPECT_EQ(batches[1].clockwise, true);
+    EXPECT_EQ(batches[1].count, 59);
+
+    advance_time(ENCODER_AGGREGATE_INTERVAL);
+    encoder_task();
+    EXPECT_EQ(batches.size(), 2);
+}
+
+TEST_F(EncoderAggregateTest, TestReversalCancelsPending) {
+    turnCounterClockwise(1);
+    turnCounterClockwise(50);
+    turnClockwise(20);
+
+    advance_time(ENCODER_AGGREGATE_INTERVAL);
+    encoder_task();
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[0].clockwise, false);
+    EXPECT_EQ(batches[0].count, 1);
+    EXPECT_EQ(batches[1].clockwise, false);
+    EXPECT_EQ(batches[1].count, 30);
+}
+
+TEST_F(EncoderAggregateTest, TestFallsBackToPerDetentCallback) {
+    batch_user_result = true;
+    turnClockwise(1);
+    turnClockwise(54);
+    advance_time(ENCODER_AGGREGATE_INTERVAL);
+    encoder_task();
+
+    EXPECT_EQ(batches.size(), 2);
+    EXPECT_EQ(detents_cw, 55);
+    EXPECT_EQ(detents_ccw, 0);
+}
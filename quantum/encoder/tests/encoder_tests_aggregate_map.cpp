@@ -0,0 +1,150 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+#include <stdio.h>
+
+extern "C" {
+#include "encoder.h"
+#include "keyboard.h"
+#include "timer.h"
+#include "encoder/tests/mock.h"
+
+void timer_clear(void);
+void advance_time(uint32_t ms);
+}
+
+struct tap_event {
+    uint8_t  index;
+    bool     clockwise;
+    bool     pressed;
+    uint32_t time;
+};
+
+std::vector<tap_event> events;
+
+extern "C" void action_exec(keyevent_t event) {
+    events.push_back({event.key.col, event.type == ENCODER_CW_EVENT, event.pressed, timer_read32()});
+}
+
+bool setAndRead(pin_t pin, bool val) {
+    setPin(pin, val);
+    return encoder_task();
+}
+
+void turnClockwise(int detents) {
+    for (int i = 0; i < detents; i++) {
+        setAndRead(0, false);
+        setAndRead(1, false);
+        setAndRead(0, true);
+        setAndRead(1, true);
+    }
+}
+
+void turnCounterClockwise(int detents) {
+    for (int i = 0; i < detents; i++) {
+        setAndRead(1, false);
+        setAndRead(0, false);
+        setAndRead(1, true);
+        setAndRead(0, true);
+    }
+}
+
+// Keeps the scan loop running until every pending tap has been emitted
+void runFor(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) {
+        advance_time(1);
+        encoder_task();
+    }
+}
+
+class EncoderAggregateMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        events.clear();
+        timer_clear();
+        encoder_init();
+    }
+
+    // Checks that events are alternating presses and releases, each held for at least ENCODER_MAP_KEY_DELAY
+    static void expectTaps(size_t first, size_t taps, bool clockwise) {
+        ASSERT_GE(events.size(), first + taps * 2);
+        for (size_t i = first; i < first + taps * 2; i++) {
+            EXPECT_EQ(events[i].index, 0);
+            EXPECT_EQ(events[i].clockwise, clockwise) << "event " << i;
+            EXPECT_EQ(events[i].pressed, (i - first) % 2 == 0) << "event " << i;
+            if (i > 0) {
+                EXPECT_GE(events[i].time - events[i - 1].time, ENCODER_MAP_KEY_DELAY) << "event " << i;
+            }
+        }
+    }
+};
+
+TEST_F(EncoderAggregateMapTest, TestOneClockwise) {
+    turnClockwise(1);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].pressed, true);
+
+    runFor(ENCODER_MAP_KEY_DELAY);
+    EXPECT_EQ(events.size(), 2);
+    expectTaps(0, 1, true);
+}
+
+TEST_F(EncoderAggregateMapTest, TestBurstDoesNotBlock) {
+    uint32_t start = timer_read32();
+    turnClockwise(64);
+
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_EQ(events.size(), 1);
+
+    runFor(64 * 2 * ENCODER_MAP_KEY_DELAY);
+    EXPECT_EQ(events.size(), 64 * 2);
+    expectTaps(0, 64, true);
+
+    runFor(100);
+    EXPECT_EQ(events.size(), 64 * 2);
+}
+
+TEST_F(EncoderAggregateMapTest, TestReversalCancelsPending) {
+    turnClockwise(50);
+    turnCounterClockwise(20);
+    runFor(100 * ENCODER_MAP_KEY_DELAY);
+
+    EXPECT_EQ(events.size(), 30 * 2);
+    expectTaps(0, 30, true);
+}
+
+TEST_F(EncoderAggregateMapTest, TestTurnBackWhileHeld) {
+    turnClockwise(1);
+    turnCounterClockwise(2);
+    runFor(10 * ENCODER_MAP_KEY_DELAY);
+
+    // The first detent had already been pressed, so both turns back still need to go out
+    EXPECT_EQ(events.size(), 3 * 2);
+    expectTaps(0, 1, true);
+    expectTaps(2, 2, false);
+}
+
+TEST_F(EncoderAggregateMapTest, TestDrainReleasesHeldKey) {
+    turnClockwise(5);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0].pressed, true);
+
+    encoder_signal_queue_drain();
+    encoder_task();
+    // Released straight away rather than after ENCODER_MAP_KEY_DELAY
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[1].clockwise, true);
+    EXPECT_EQ(events[1].pressed, false);
+
+    // The remaining detents were dropped, and the next one waits out the release
+    runFor(10 * ENCODER_MAP_KEY_DELAY);
+    EXPECT_EQ(events.size(), 2);
+
+    turnCounterClockwise(1);
+    runFor(ENCODER_MAP_KEY_DELAY);
+    EXPECT_EQ(events.size(), 4);
+    expectTaps(2, 1, false);
+}
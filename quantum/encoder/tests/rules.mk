@@ -73,3 +73,25 @@ encoder_split_role_SRC := \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests_split_role.cpp \
 	$(QUANTUM_PATH)/encoder.c
+
+encoder_aggregate_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE
+encoder_aggregate_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_aggregate.h
+
+encoder_aggregate_SRC := \
+	$(PLATFORM_PATH)/timer.c \
+	platforms/test/timer.c \
+	drivers/encoder/encoder_quadrature.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_aggregate.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
+encoder_aggregate_map_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_MAP_ENABLE
+encoder_aggregate_map_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_aggregate.h
+
+encoder_aggregate_map_SRC := \
+	$(PLATFORM_PATH)/timer.c \
+	platforms/test/timer.c \
+	drivers/encoder/encoder_quadrature.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_tests_aggregate_map.cpp \
+	$(QUANTUM_PATH)/encoder.c
@@ -6,3 +6,5 @@ TEST_LIST += \
 	encoder_split_no_left \
 	encoder_split_no_right \
 	encoder_split_role \
+	encoder_aggregate \
+	encoder_aggregate_map \
@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "eeconfig.h"
 #include "action_layer.h"
 #include "suspend.h"
+#include "scan_profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -78,12 +79,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef STENO_ENABLE
 #    include "process_steno.h"
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef KEY_OVERRIDE_ENABLE
 #    include "process_key_override.h"
 #endif
 #ifdef SECURE_ENABLE
 #    include "secure.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string.h"
+#endif
 #ifdef POINTING_DEVICE_ENABLE
 #    include "pointing_device.h"
 #endif
@@ -105,6 +112,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#ifdef VIA_BULK_ENABLE
+#    include "via_bulk.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -420,9 +436,25 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
-    housekeeping_task_modules();
-    housekeeping_task_kb();
-    housekeeping_task_user();
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_HOUSEKEEPING, {
+        housekeeping_task_modules();
+        housekeeping_task_kb();
+        housekeeping_task_user();
+    });
+
+#ifdef SCAN_PROFILER_ENABLE
+    scan_profiler_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+    // Erasing flash can stall for a while, so make progress when nobody is typing, or once it's been put off for too long
+    static uint32_t wear_leveling_pending_since = 0;
+    if (!wear_leveling_consolidate_pending()) {
+        wear_leveling_pending_since = timer_read32();
+    } else if (last_input_activity_elapsed() >= WEAR_LEVELING_BACKGROUND_IDLE_TIME || timer_elapsed32(wear_leveling_pending_since) >= WEAR_LEVELING_BACKGROUND_MAX_PENDING_TIME) {
+        wear_leveling_consolidate_step();
+    }
+#endif
 }
 
 /** \brief quantum_init
@@ -510,6 +542,9 @@ void keyboard_init(void) {
 #ifdef STENO_ENABLE_ALL
     steno_init();
 #endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
 #if defined(NKRO_ENABLE) && defined(FORCE_NKRO)
 #    pragma message "FORCE_NKRO option is now deprecated - Please migrate to NKRO_DEFAULT_ON instead."
     keymap_config.nkro = 1;
@@ -699,36 +734,57 @@ void quantum_task(void) {
     secure_task();
 #endif
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_task();
+#endif
+
 #ifdef LAYER_LOCK_ENABLE
     layer_lock_task();
 #endif
 
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_task();
+#endif
+
+#ifdef VIA_BULK_ENABLE
+    via_bulk_task();
+#endif
+
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_task();
+#endif
+
     host_task();
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+#ifdef SCAN_PROFILER_ENABLE
+    const uint32_t keyboard_task_start = scan_profiler_read_cycles();
+#endif
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool                         matrix_changed;
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_MATRIX, matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_QUANTUM, quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_RGBLIGHT, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_LED_MATRIX, led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_RGB_MATRIX, rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -738,21 +794,25 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_task()) {
+    bool encoder_changed;
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_ENCODER, encoder_changed = encoder_task());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_POINTING_DEVICE, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    SCAN_PROFILE(SCAN_PROFILER_STAGE_OLED, oled_task());
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -801,4 +861,8 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#ifdef SCAN_PROFILER_ENABLE
+    scan_profiler_record(SCAN_PROFILER_STAGE_KEYBOARD_TASK, scan_profiler_read_cycles() - keyboard_task_start);
+#endif
 }
@@ -119,6 +119,23 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
     return combo_get_raw(combo_idx);
 }
 
+#    if defined(COMBO_INDEX_ENABLE)
+
+// Sized for the worst case, so that the keymap's combos always fit
+static uint16_t combo_index_storage_buffer[ARRAY_SIZE(key_combos) * (COMBO_INDEX_ENTRIES_PER_COMBO)];
+
+STATIC_ASSERT(ARRAY_SIZE(combo_index_storage_buffer) <= UINT16_MAX, "Too many combos for the combo index. Disable COMBO_INDEX_ENABLE or use fewer combos.");
+
+uint16_t* combo_index_storage_raw(uint16_t* capacity) {
+    *capacity = ARRAY_SIZE(combo_index_storage_buffer);
+    return combo_index_storage_buffer;
+}
+__attribute__((weak)) uint16_t* combo_index_storage(uint16_t* capacity) {
+    return combo_index_storage_raw(capacity);
+}
+
+#    endif // defined(COMBO_INDEX_ENABLE)
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
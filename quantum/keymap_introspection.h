@@ -66,6 +66,13 @@ combo_t* combo_get_raw(uint16_t combo_idx);
 // Get the combo definition, potentially stored dynamically
 combo_t* combo_get(uint16_t combo_idx);
 
+#    if defined(COMBO_INDEX_ENABLE)
+// Get the storage for the combo index, sized for the combos defined in the user's keymap
+uint16_t* combo_index_storage_raw(uint16_t* capacity);
+// Get the storage for the combo index, potentially sized for combos stored dynamically
+uint16_t* combo_index_storage(uint16_t* capacity);
+#    endif // defined(COMBO_INDEX_ENABLE)
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
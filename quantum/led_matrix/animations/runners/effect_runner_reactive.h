@@ -8,6 +8,8 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     LED_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint16_t max_tick = 65535 / led_matrix_eeconfig.speed;
+    // LEDs without a hit all look the same
+    uint8_t background = effect_func(led_matrix_eeconfig.val, scale16by8(max_tick, led_matrix_eeconfig.speed));
     for (uint8_t i = led_min; i < led_max; i++) {
         LED_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
@@ -19,8 +21,12 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
             }
         }
 
-        uint16_t offset = scale16by8(tick, led_matrix_eeconfig.speed);
-        led_matrix_set_value(i, effect_func(led_matrix_eeconfig.val, offset));
+        uint8_t val = background;
+        if (tick < max_tick) {
+            uint16_t offset = scale16by8(tick, led_matrix_eeconfig.speed);
+            val             = effect_func(led_matrix_eeconfig.val, offset);
+        }
+        led_matrix_set_value(i, val);
     }
     return led_matrix_check_finished_leds(led_max);
 }
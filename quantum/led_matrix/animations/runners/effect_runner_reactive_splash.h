@@ -3,6 +3,33 @@
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 
 typedef uint8_t (*reactive_splash_f)(uint8_t val, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// Returns how far a hit reaches at the given tick: LEDs at this distance or further away are left untouched
+typedef uint16_t (*reactive_splash_reach_f)(uint16_t tick);
+
+#    ifdef LED_MATRIX_SPLASH_DISTANCE_TABLE
+// Distance between two LEDs, looked up in the lower triangle generated from g_led_config.point
+static inline uint8_t effect_runner_splash_distance(uint8_t a, uint8_t b) {
+    if (a == b) {
+        return 0;
+    }
+    if (a < b) {
+        uint8_t t = a;
+        a         = b;
+        b         = t;
+    }
+    return pgm_read_byte(&g_led_matrix_splash_distance[(uint16_t)a * (a - 1) / 2 + b]);
+}
+#    endif
+
+static inline uint8_t effect_runner_splash_hit_distance(uint8_t i, uint8_t j) {
+#    ifdef LED_MATRIX_SPLASH_DISTANCE_TABLE
+    return effect_runner_splash_distance(i, g_last_hit_tracker.index[j]);
+#    else
+    int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+    int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+    return sqrt16(dx * dx + dy * dy);
+#    endif
+}
 
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     LED_MATRIX_USE_LIMITS(led_min, led_max);
@@ -14,7 +41,7 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
         for (uint8_t j = start; j < count; j++) {
             int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
             int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
+            uint8_t  dist = effect_runner_splash_hit_distance(i, j);
             uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], led_matrix_eeconfig.speed);
             val           = effect_func(val, dx, dy, dist, tick);
         }
@@ -23,4 +50,37 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return led_matrix_check_finished_leds(led_max);
 }
 
+// Same as effect_runner_reactive_splash(), but only runs the effect for hits within reach of the LED
+bool effect_runner_reactive_splash_sparse(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
+    LED_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t  count  = g_last_hit_tracker.count;
+    bool     active = false;
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    uint16_t reach[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        tick[j]  = scale16by8(g_last_hit_tracker.tick[j], led_matrix_eeconfig.speed);
+        reach[j] = reach_func(tick[j]);
+        active |= reach[j] > 0;
+    }
+
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LED_MATRIX_TEST_LED_FLAGS();
+        uint8_t val = 0;
+        for (uint8_t j = start; j < count && active; j++) {
+            if (reach[j] == 0) {
+                continue;
+            }
+            uint8_t dist = effect_runner_splash_hit_distance(i, j);
+            if (dist < reach[j]) {
+                int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                val        = effect_func(val, dx, dy, dist, tick[j]);
+            }
+        }
+        led_matrix_set_value(i, scale8(val, led_matrix_eeconfig.val));
+    }
+    return led_matrix_check_finished_leds(led_max);
+}
+
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
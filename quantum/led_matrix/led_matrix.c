@@ -69,6 +69,9 @@ uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_POLAR_EFFECTS
+led_polar_t g_led_matrix_polar[LED_MATRIX_LED_COUNT];
+#endif // LED_MATRIX_POLAR_EFFECTS
 
 #ifndef LED_MATRIX_FLAG_STEPS
 #    define LED_MATRIX_FLAG_STEPS {LED_FLAG_ALL, LED_FLAG_KEYLIGHT | LED_FLAG_MODIFIER, LED_FLAG_NONE}
@@ -452,8 +455,20 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     return limits;
 }
 
+void led_matrix_update_polar_cache(void) {
+#ifdef LED_MATRIX_POLAR_EFFECTS
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        int16_t dx                  = g_led_config.point[i].x - k_led_matrix_center.x;
+        int16_t dy                  = g_led_config.point[i].y - k_led_matrix_center.y;
+        g_led_matrix_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_matrix_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif // LED_MATRIX_POLAR_EFFECTS
+}
+
 void led_matrix_init(void) {
     led_matrix_driver.init();
+    led_matrix_update_polar_cache();
 
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -147,6 +147,7 @@ bool led_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void led_matrix_init(void);
+void led_matrix_update_polar_cache(void);
 
 void led_matrix_reload_from_eeprom(void);
 
@@ -210,6 +211,12 @@ extern uint32_t     g_led_timer;
 extern led_config_t g_led_config;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+#    ifdef LED_MATRIX_SPLASH_DISTANCE_TABLE
+extern const uint8_t g_led_matrix_splash_distance[];
+#    endif
+#endif
+#ifdef LED_MATRIX_POLAR_EFFECTS
+extern led_polar_t g_led_matrix_polar[LED_MATRIX_LED_COUNT];
 #endif
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
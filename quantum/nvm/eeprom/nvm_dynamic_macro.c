@@ -0,0 +1,60 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "nvm_dynamic_macro.h"
+
+#ifdef DYNAMIC_MACRO_PERSIST
+#    include "compiler_support.h"
+#    include "nvm_eeprom_eeconfig_internal.h"
+#    include "nvm_eeprom_dynamic_macro_internal.h"
+
+// Bumped whenever the event encoding changes, so that stale macros are discarded rather than replayed
+#    define DYNAMIC_MACRO_EEPROM_VERSION 1
+
+STATIC_ASSERT((int64_t)(DYNAMIC_MACRO_EEPROM_ADDR) >= (int64_t)(EECONFIG_SIZE), "Dynamic macros are configured to overlap with eeconfig.");
+STATIC_ASSERT((int64_t)(DYNAMIC_MACRO_EEPROM_ADDR) + (int64_t)(DYNAMIC_MACRO_EEPROM_SIZE) <= (int64_t)(TOTAL_EEPROM_BYTE_COUNT), "Dynamic macros are configured to use more EEPROM than is available.");
+
+#    define DYNAMIC_MACRO_EEPROM_VERSION_ADDR ((uint8_t *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_ADDR))
+#    define DYNAMIC_MACRO_EEPROM_LENGTHS_ADDR ((uint16_t *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_ADDR + 1))
+#    define DYNAMIC_MACRO_EEPROM_DATA_ADDR (DYNAMIC_MACRO_EEPROM_ADDR + DYNAMIC_MACRO_EEPROM_HEADER_SIZE)
+
+void nvm_dynamic_macro_erase(void) {
+    // nvm_eeconfig_erase() does not necessarily erase EEPROM, so drop the stored macros by invalidating their header
+    eeprom_update_byte(DYNAMIC_MACRO_EEPROM_VERSION_ADDR, 0xFF);
+}
+
+bool nvm_dynamic_macro_read_lengths(uint16_t *macro1_length, uint16_t *macro2_length) {
+    if (eeprom_read_byte(DYNAMIC_MACRO_EEPROM_VERSION_ADDR) != DYNAMIC_MACRO_EEPROM_VERSION) {
+        return false;
+    }
+    *macro1_length = eeprom_read_word(DYNAMIC_MACRO_EEPROM_LENGTHS_ADDR);
+    *macro2_length = eeprom_read_word(DYNAMIC_MACRO_EEPROM_LENGTHS_ADDR + 1);
+    return (uint32_t)*macro1_length + *macro2_length <= DYNAMIC_MACRO_BUFFER_SIZE;
+}
+
+void nvm_dynamic_macro_update_lengths(uint16_t macro1_length, uint16_t macro2_length) {
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTHS_ADDR, macro1_length);
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_LENGTHS_ADDR + 1, macro2_length);
+    eeprom_update_byte(DYNAMIC_MACRO_EEPROM_VERSION_ADDR, DYNAMIC_MACRO_EEPROM_VERSION);
+}
+
+void nvm_dynamic_macro_read_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
+    if (offset >= DYNAMIC_MACRO_BUFFER_SIZE) {
+        return;
+    }
+    if (size > DYNAMIC_MACRO_BUFFER_SIZE - offset) {
+        size = DYNAMIC_MACRO_BUFFER_SIZE - offset;
+    }
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_DATA_ADDR + offset), size);
+}
+
+void nvm_dynamic_macro_update_buffer(uint32_t offset, uint32_t size, const uint8_t *data) {
+    if (offset >= DYNAMIC_MACRO_BUFFER_SIZE) {
+        return;
+    }
+    if (size > DYNAMIC_MACRO_BUFFER_SIZE - offset) {
+        size = DYNAMIC_MACRO_BUFFER_SIZE - offset;
+    }
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_DATA_ADDR + offset), size);
+}
+#endif // DYNAMIC_MACRO_PERSIST
@@ -45,40 +45,165 @@
 #    include "connection.h"
 #endif
 
+#ifdef EECONFIG_WRITE_BEHIND
+#    include "timer.h"
+
+// RAM copy of the eeconfig area, so that rapid successive updates (brightness, hue, modes...) don't each reach EEPROM.
+// Updates are applied here and marked dirty a byte at a time, then written back in contiguous runs once no further
+// updates have been made for EECONFIG_WRITE_BEHIND_DELAY.
+static uint8_t  eeconfig_cache[EECONFIG_SIZE];
+static uint8_t  eeconfig_cache_dirty[(EECONFIG_SIZE + 7) / 8];
+static bool     eeconfig_cache_loaded      = false;
+static bool     eeconfig_cache_pending     = false;
+static uint16_t eeconfig_cache_last_update = 0;
+
+static inline bool eeconfig_cache_is_dirty(uint16_t offset) {
+    return eeconfig_cache_dirty[offset / 8] & (1 << (offset % 8));
+}
+
+static void eeconfig_cache_ensure_loaded(void) {
+    // Loaded on first use rather than at init, so that it always reflects a preceding format
+    if (!eeconfig_cache_loaded) {
+        eeprom_read_block(eeconfig_cache, (const void *)0, EECONFIG_SIZE);
+        eeconfig_cache_loaded = true;
+    }
+}
+
+static void eeconfig_cache_invalidate(void) {
+    memset(eeconfig_cache_dirty, 0, sizeof(eeconfig_cache_dirty));
+    eeconfig_cache_loaded  = false;
+    eeconfig_cache_pending = false;
+}
+
+static void eeconfig_cache_read_block(void *buf, const void *addr, size_t len) {
+    eeconfig_cache_ensure_loaded();
+    memcpy(buf, &eeconfig_cache[(uintptr_t)addr], len);
+}
+
+static void eeconfig_cache_update_block(const void *buf, void *addr, size_t len) {
+    eeconfig_cache_ensure_loaded();
+    const uint8_t *p      = (const uint8_t *)buf;
+    uint16_t       offset = (uintptr_t)addr;
+    for (size_t i = 0; i < len; ++i, ++offset) {
+        if (eeconfig_cache[offset] != p[i]) {
+            eeconfig_cache[offset] = p[i];
+            eeconfig_cache_dirty[offset / 8] |= 1 << (offset % 8);
+            eeconfig_cache_pending     = true;
+            eeconfig_cache_last_update = timer_read();
+        }
+    }
+}
+
+// Multi-byte values are stored little-endian, matching the EEPROM drivers
+static uint8_t eeconfig_cache_read_byte(const uint8_t *addr) {
+    uint8_t buf[1];
+    eeconfig_cache_read_block(buf, addr, sizeof(buf));
+    return buf[0];
+}
+static uint16_t eeconfig_cache_read_word(const uint16_t *addr) {
+    uint8_t buf[2];
+    eeconfig_cache_read_block(buf, addr, sizeof(buf));
+    return buf[0] | ((uint16_t)buf[1] << 8);
+}
+static uint32_t eeconfig_cache_read_dword(const uint32_t *addr) {
+    uint8_t buf[4];
+    eeconfig_cache_read_block(buf, addr, sizeof(buf));
+    return buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+static void eeconfig_cache_update_byte(uint8_t *addr, uint8_t value) {
+    eeconfig_cache_update_block(&value, addr, 1);
+}
+static void eeconfig_cache_update_word(uint16_t *addr, uint16_t value) {
+    uint8_t buf[2] = {value, value >> 8};
+    eeconfig_cache_update_block(buf, addr, sizeof(buf));
+}
+static void eeconfig_cache_update_dword(uint32_t *addr, uint32_t value) {
+    uint8_t buf[4] = {value, value >> 8, value >> 16, value >> 24};
+    eeconfig_cache_update_block(buf, addr, sizeof(buf));
+}
+#else
+#    define eeconfig_cache_read_byte eeprom_read_byte
+#    define eeconfig_cache_read_word eeprom_read_word
+#    define eeconfig_cache_read_dword eeprom_read_dword
+#    define eeconfig_cache_read_block eeprom_read_block
+#    define eeconfig_cache_update_byte eeprom_update_byte
+#    define eeconfig_cache_update_word eeprom_update_word
+#    define eeconfig_cache_update_dword eeprom_update_dword
+#    define eeconfig_cache_update_block eeprom_update_block
+#endif // EECONFIG_WRITE_BEHIND
+
+void nvm_eeconfig_flush(void) {
+#ifdef EECONFIG_WRITE_BEHIND
+    if (!eeconfig_cache_pending) {
+        return;
+    }
+    // Each contiguous run of dirty bytes is written with a single block update, so that e.g. an RGB matrix config
+    // becomes one wear-leveling write rather than one per field
+    uint16_t offset = 0;
+    while (offset < EECONFIG_SIZE) {
+        if (!eeconfig_cache_is_dirty(offset)) {
+            ++offset;
+            continue;
+        }
+        uint16_t start = offset;
+        while (offset < EECONFIG_SIZE && eeconfig_cache_is_dirty(offset)) {
+            ++offset;
+        }
+        eeprom_update_block(&eeconfig_cache[start], (void *)(uintptr_t)start, offset - start);
+    }
+    memset(eeconfig_cache_dirty, 0, sizeof(eeconfig_cache_dirty));
+    eeconfig_cache_pending = false;
+#endif // EECONFIG_WRITE_BEHIND
+}
+
+void nvm_eeconfig_task(void) {
+#ifdef EECONFIG_WRITE_BEHIND
+    if (eeconfig_cache_pending && timer_elapsed(eeconfig_cache_last_update) >= EECONFIG_WRITE_BEHIND_DELAY) {
+        nvm_eeconfig_flush();
+    }
+#endif // EECONFIG_WRITE_BEHIND
+}
+
 void nvm_eeconfig_erase(void) {
 #ifdef EEPROM_DRIVER
     eeprom_driver_format(false);
 #endif // EEPROM_DRIVER
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_cache_invalidate();
+#endif // EECONFIG_WRITE_BEHIND
 }
 
 bool nvm_eeconfig_is_enabled(void) {
-    return eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER;
+    return eeconfig_cache_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER;
 }
 
 bool nvm_eeconfig_is_disabled(void) {
-    return eeprom_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF;
+    return eeconfig_cache_read_word(EECONFIG_MAGIC) == EECONFIG_MAGIC_NUMBER_OFF;
 }
 
 void nvm_eeconfig_enable(void) {
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
+    eeconfig_cache_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER);
 }
 
 void nvm_eeconfig_disable(void) {
 #if defined(EEPROM_DRIVER)
     eeprom_driver_format(false);
 #endif
-    eeprom_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_cache_invalidate();
+#endif // EECONFIG_WRITE_BEHIND
+    eeconfig_cache_update_word(EECONFIG_MAGIC, EECONFIG_MAGIC_NUMBER_OFF);
 }
 
 void nvm_eeconfig_read_debug(debug_config_t *debug_config) {
-    debug_config->raw = eeprom_read_byte(EECONFIG_DEBUG);
+    debug_config->raw = eeconfig_cache_read_byte(EECONFIG_DEBUG);
 }
 void nvm_eeconfig_update_debug(const debug_config_t *debug_config) {
-    eeprom_update_byte(EECONFIG_DEBUG, debug_config->raw);
+    eeconfig_cache_update_byte(EECONFIG_DEBUG, debug_config->raw);
 }
 
 layer_state_t nvm_eeconfig_read_default_layer(void) {
-    uint8_t val = eeprom_read_byte(EECONFIG_DEFAULT_LAYER);
+    uint8_t val = eeconfig_cache_read_byte(EECONFIG_DEFAULT_LAYER);
 #ifdef DEFAULT_LAYER_STATE_IS_VALUE_NOT_BITMASK
     // stored as a layer number, so convert back to bitmask
     return (layer_state_t)1 << val;
@@ -95,49 +220,49 @@ void nvm_eeconfig_update_default_layer(layer_state_t state) {
     // stored as 8-bit-wide bitmask, so write the value directly - handling truncation from 16/32 bit layer_state_t
     uint8_t val = (uint8_t)state;
 #endif
-    eeprom_update_byte(EECONFIG_DEFAULT_LAYER, val);
+    eeconfig_cache_update_byte(EECONFIG_DEFAULT_LAYER, val);
 }
 
 void nvm_eeconfig_read_keymap(keymap_config_t *keymap_config) {
-    keymap_config->raw = eeprom_read_word(EECONFIG_KEYMAP);
+    keymap_config->raw = eeconfig_cache_read_word(EECONFIG_KEYMAP);
 }
 void nvm_eeconfig_update_keymap(const keymap_config_t *keymap_config) {
-    eeprom_update_word(EECONFIG_KEYMAP, keymap_config->raw);
+    eeconfig_cache_update_word(EECONFIG_KEYMAP, keymap_config->raw);
 }
 
 #ifdef AUDIO_ENABLE
 void nvm_eeconfig_read_audio(audio_config_t *audio_config) {
-    audio_config->raw = eeprom_read_byte(EECONFIG_AUDIO);
+    audio_config->raw = eeconfig_cache_read_byte(EECONFIG_AUDIO);
 }
 void nvm_eeconfig_update_audio(const audio_config_t *audio_config) {
-    eeprom_update_byte(EECONFIG_AUDIO, audio_config->raw);
+    eeconfig_cache_update_byte(EECONFIG_AUDIO, audio_config->raw);
 }
 #endif // AUDIO_ENABLE
 
 #ifdef UNICODE_COMMON_ENABLE
 void nvm_eeconfig_read_unicode_mode(unicode_config_t *unicode_config) {
-    unicode_config->raw = eeprom_read_byte(EECONFIG_UNICODEMODE);
+    unicode_config->raw = eeconfig_cache_read_byte(EECONFIG_UNICODEMODE);
 }
 void nvm_eeconfig_update_unicode_mode(const unicode_config_t *unicode_config) {
-    eeprom_update_byte(EECONFIG_UNICODEMODE, unicode_config->raw);
+    eeconfig_cache_update_byte(EECONFIG_UNICODEMODE, unicode_config->raw);
 }
 #endif // UNICODE_COMMON_ENABLE
 
 #ifdef BACKLIGHT_ENABLE
 void nvm_eeconfig_read_backlight(backlight_config_t *backlight_config) {
-    backlight_config->raw = eeprom_read_byte(EECONFIG_BACKLIGHT);
+    backlight_config->raw = eeconfig_cache_read_byte(EECONFIG_BACKLIGHT);
 }
 void nvm_eeconfig_update_backlight(const backlight_config_t *backlight_config) {
-    eeprom_update_byte(EECONFIG_BACKLIGHT, backlight_config->raw);
+    eeconfig_cache_update_byte(EECONFIG_BACKLIGHT, backlight_config->raw);
 }
 #endif // BACKLIGHT_ENABLE
 
 #ifdef STENO_ENABLE
 uint8_t nvm_eeconfig_read_steno_mode(void) {
-    return eeprom_read_byte(EECONFIG_STENOMODE);
+    return eeconfig_cache_read_byte(EECONFIG_STENOMODE);
 }
 void nvm_eeconfig_update_steno_mode(uint8_t val) {
-    eeprom_update_byte(EECONFIG_STENOMODE, val);
+    eeconfig_cache_update_byte(EECONFIG_STENOMODE, val);
 }
 #endif // STENO_ENABLE
 
@@ -146,87 +271,87 @@ void nvm_eeconfig_update_steno_mode(uint8_t val) {
 
 #ifdef RGB_MATRIX_ENABLE
 void nvm_eeconfig_read_rgb_matrix(rgb_config_t *rgb_matrix_config) {
-    eeprom_read_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
+    eeconfig_cache_read_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
 }
 void nvm_eeconfig_update_rgb_matrix(const rgb_config_t *rgb_matrix_config) {
-    eeprom_update_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
+    eeconfig_cache_update_block(rgb_matrix_config, EECONFIG_RGB_MATRIX, sizeof(rgb_config_t));
 }
 #endif // RGB_MATRIX_ENABLE
 
 #ifdef LED_MATRIX_ENABLE
 void nvm_eeconfig_read_led_matrix(led_eeconfig_t *led_matrix_config) {
-    eeprom_read_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
+    eeconfig_cache_read_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
 }
 void nvm_eeconfig_update_led_matrix(const led_eeconfig_t *led_matrix_config) {
-    eeprom_update_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
+    eeconfig_cache_update_block(led_matrix_config, EECONFIG_LED_MATRIX, sizeof(led_eeconfig_t));
 }
 #endif // LED_MATRIX_ENABLE
 
 #ifdef RGBLIGHT_ENABLE
 void nvm_eeconfig_read_rgblight(rgblight_config_t *rgblight_config) {
-    rgblight_config->raw = eeprom_read_dword(EECONFIG_RGBLIGHT);
-    rgblight_config->raw |= ((uint64_t)eeprom_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32);
+    rgblight_config->raw = eeconfig_cache_read_dword(EECONFIG_RGBLIGHT);
+    rgblight_config->raw |= ((uint64_t)eeconfig_cache_read_byte(EECONFIG_RGBLIGHT_EXTENDED) << 32);
 }
 void nvm_eeconfig_update_rgblight(const rgblight_config_t *rgblight_config) {
-    eeprom_update_dword(EECONFIG_RGBLIGHT, rgblight_config->raw & 0xFFFFFFFF);
-    eeprom_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (rgblight_config->raw >> 32) & 0xFF);
+    eeconfig_cache_update_dword(EECONFIG_RGBLIGHT, rgblight_config->raw & 0xFFFFFFFF);
+    eeconfig_cache_update_byte(EECONFIG_RGBLIGHT_EXTENDED, (rgblight_config->raw >> 32) & 0xFF);
 }
 #endif // RGBLIGHT_ENABLE
 
 #if (EECONFIG_KB_DATA_SIZE) == 0
 uint32_t nvm_eeconfig_read_kb(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD);
+    return eeconfig_cache_read_dword(EECONFIG_KEYBOARD);
 }
 void nvm_eeconfig_update_kb(uint32_t val) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, val);
+    eeconfig_cache_update_dword(EECONFIG_KEYBOARD, val);
 }
 #endif // (EECONFIG_KB_DATA_SIZE) == 0
 
 #if (EECONFIG_USER_DATA_SIZE) == 0
 uint32_t nvm_eeconfig_read_user(void) {
-    return eeprom_read_dword(EECONFIG_USER);
+    return eeconfig_cache_read_dword(EECONFIG_USER);
 }
 void nvm_eeconfig_update_user(uint32_t val) {
-    eeprom_update_dword(EECONFIG_USER, val);
+    eeconfig_cache_update_dword(EECONFIG_USER, val);
 }
 #endif // (EECONFIG_USER_DATA_SIZE) == 0
 
 #ifdef HAPTIC_ENABLE
 void nvm_eeconfig_read_haptic(haptic_config_t *haptic_config) {
-    haptic_config->raw = eeprom_read_dword(EECONFIG_HAPTIC);
+    haptic_config->raw = eeconfig_cache_read_dword(EECONFIG_HAPTIC);
 }
 void nvm_eeconfig_update_haptic(const haptic_config_t *haptic_config) {
-    eeprom_update_dword(EECONFIG_HAPTIC, haptic_config->raw);
+    eeconfig_cache_update_dword(EECONFIG_HAPTIC, haptic_config->raw);
 }
 #endif // HAPTIC_ENABLE
 
 #ifdef CONNECTION_ENABLE
 void nvm_eeconfig_read_connection(connection_config_t *config) {
-    config->raw = eeprom_read_byte(EECONFIG_CONNECTION);
+    config->raw = eeconfig_cache_read_byte(EECONFIG_CONNECTION);
 }
 void nvm_eeconfig_update_connection(const connection_config_t *config) {
-    eeprom_update_byte(EECONFIG_CONNECTION, config->raw);
+    eeconfig_cache_update_byte(EECONFIG_CONNECTION, config->raw);
 }
 #endif // CONNECTION_ENABLE
 
 bool nvm_eeconfig_read_handedness(void) {
-    return !!eeprom_read_byte(EECONFIG_HANDEDNESS);
+    return !!eeconfig_cache_read_byte(EECONFIG_HANDEDNESS);
 }
 void nvm_eeconfig_update_handedness(bool val) {
-    eeprom_update_byte(EECONFIG_HANDEDNESS, !!val);
+    eeconfig_cache_update_byte(EECONFIG_HANDEDNESS, !!val);
 }
 
 #if (EECONFIG_KB_DATA_SIZE) > 0
 
 bool nvm_eeconfig_is_kb_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
+    return eeconfig_cache_read_dword(EECONFIG_KEYBOARD) == (EECONFIG_KB_DATA_VERSION);
 }
 
 uint32_t nvm_eeconfig_read_kb_datablock(void *data, uint32_t offset, uint32_t length) {
     if (eeconfig_is_kb_datablock_valid()) {
         void *ee_start = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + offset);
         void *ee_end   = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + MIN(EECONFIG_KB_DATA_SIZE, offset + length));
-        eeprom_read_block(data, ee_start, ee_end - ee_start);
+        eeconfig_cache_read_block(data, ee_start, ee_end - ee_start);
         return ee_end - ee_start;
     } else {
         memset(data, 0, length);
@@ -235,16 +360,16 @@ uint32_t nvm_eeconfig_read_kb_datablock(void *data, uint32_t offset, uint32_t le
 }
 
 uint32_t nvm_eeconfig_update_kb_datablock(const void *data, uint32_t offset, uint32_t length) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    eeconfig_cache_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
 
     void *ee_start = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + offset);
     void *ee_end   = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + MIN(EECONFIG_KB_DATA_SIZE, offset + length));
-    eeprom_update_block(data, ee_start, ee_end - ee_start);
+    eeconfig_cache_update_block(data, ee_start, ee_end - ee_start);
     return ee_end - ee_start;
 }
 
 void nvm_eeconfig_init_kb_datablock(void) {
-    eeprom_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
+    eeconfig_cache_update_dword(EECONFIG_KEYBOARD, (EECONFIG_KB_DATA_VERSION));
 
     void   *start     = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK);
     void   *end       = (void *)(uintptr_t)(EECONFIG_KB_DATABLOCK + EECONFIG_KB_DATA_SIZE);
@@ -252,7 +377,7 @@ void nvm_eeconfig_init_kb_datablock(void) {
     uint8_t dummy[16] = {0};
     for (int i = 0; i < EECONFIG_KB_DATA_SIZE; i += sizeof(dummy)) {
         int this_loop = remaining < sizeof(dummy) ? remaining : sizeof(dummy);
-        eeprom_update_block(dummy, start, this_loop);
+        eeconfig_cache_update_block(dummy, start, this_loop);
         start += this_loop;
         remaining -= this_loop;
     }
@@ -263,14 +388,14 @@ void nvm_eeconfig_init_kb_datablock(void) {
 #if (EECONFIG_USER_DATA_SIZE) > 0
 
 bool nvm_eeconfig_is_user_datablock_valid(void) {
-    return eeprom_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
+    return eeconfig_cache_read_dword(EECONFIG_USER) == (EECONFIG_USER_DATA_VERSION);
 }
 
 uint32_t nvm_eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t length) {
     if (eeconfig_is_user_datablock_valid()) {
         void *ee_start = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + offset);
         void *ee_end   = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + MIN(EECONFIG_USER_DATA_SIZE, offset + length));
-        eeprom_read_block(data, ee_start, ee_end - ee_start);
+        eeconfig_cache_read_block(data, ee_start, ee_end - ee_start);
         return ee_end - ee_start;
     } else {
         memset(data, 0, length);
@@ -279,16 +404,16 @@ uint32_t nvm_eeconfig_read_user_datablock(void *data, uint32_t offset, uint32_t
 }
 
 uint32_t nvm_eeconfig_update_user_datablock(const void *data, uint32_t offset, uint32_t length) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_cache_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
 
     void *ee_start = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + offset);
     void *ee_end   = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + MIN(EECONFIG_USER_DATA_SIZE, offset + length));
-    eeprom_update_block(data, ee_start, ee_end - ee_start);
+    eeconfig_cache_update_block(data, ee_start, ee_end - ee_start);
     return ee_end - ee_start;
 }
 
 void nvm_eeconfig_init_user_datablock(void) {
-    eeprom_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
+    eeconfig_cache_update_dword(EECONFIG_USER, (EECONFIG_USER_DATA_VERSION));
 
     void   *start     = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK);
     void   *end       = (void *)(uintptr_t)(EECONFIG_USER_DATABLOCK + EECONFIG_USER_DATA_SIZE);
@@ -296,7 +421,7 @@ void nvm_eeconfig_init_user_datablock(void) {
     uint8_t dummy[16] = {0};
     for (int i = 0; i < EECONFIG_USER_DATA_SIZE; i += sizeof(dummy)) {
         int this_loop = remaining < sizeof(dummy) ? remaining : sizeof(dummy);
-        eeprom_update_block(dummy, start, this_loop);
+        eeconfig_cache_update_block(dummy, start, this_loop);
         start += this_loop;
         remaining -= this_loop;
     }
@@ -0,0 +1,15 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "eeprom.h"
+#include "process_dynamic_macro.h"
+
+// Format version followed by both macro lengths, then a copy of the macro buffer
+#define DYNAMIC_MACRO_EEPROM_HEADER_SIZE 5
+#define DYNAMIC_MACRO_EEPROM_SIZE (DYNAMIC_MACRO_EEPROM_HEADER_SIZE + DYNAMIC_MACRO_BUFFER_SIZE)
+
+// Dynamic macros are stored at the very end of EEPROM by default, dynamic keymaps stop short of them
+#ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#    define DYNAMIC_MACRO_EEPROM_ADDR (TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_MACRO_EEPROM_SIZE)
+#endif
@@ -0,0 +1,14 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void nvm_dynamic_macro_erase(void);
+
+bool nvm_dynamic_macro_read_lengths(uint16_t *macro1_length, uint16_t *macro2_length);
+void nvm_dynamic_macro_update_lengths(uint16_t macro1_length, uint16_t macro2_length);
+
+void nvm_dynamic_macro_read_buffer(uint32_t offset, uint32_t size, uint8_t *data);
+void nvm_dynamic_macro_update_buffer(uint32_t offset, uint32_t size, const uint8_t *data);
@@ -13,6 +13,9 @@
 
 void nvm_eeconfig_erase(void);
 
+void nvm_eeconfig_flush(void);
+void nvm_eeconfig_task(void);
+
 bool nvm_eeconfig_is_enabled(void);
 bool nvm_eeconfig_is_disabled(void);
 
@@ -56,6 +56,31 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the number of unicode glyph table entries remembered per loaded font, so that repeatedly drawn
+ *      non-ASCII glyphs skip the unicode table lookup. Each entry requires 6 bytes of RAM per font. Set to 0 to
+ *      disable.
+ */
+#    define QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE 8
+#endif // QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the size in bytes of the arena holding rendered glyphs, already converted to the display's native
+ *      pixel format. Repeatedly drawing the same glyphs with the same font and colors then skips decoding entirely,
+ *      with the least recently used glyphs evicted when the arena fills. Defaults to 0, which disables the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_SIZE 0
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs held in the glyph cache, regardless of the space left in the arena.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
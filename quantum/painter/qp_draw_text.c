@@ -21,6 +21,11 @@ typedef struct qff_font_handle_t {
     bool                  has_palette;
     bool                  is_panel_native;
     painter_compression_t compression_scheme;
+    bool                  unicode_table_sorted; // allows binary searching the unicode table
+    uint32_t              glyph_data_offset;    // start of the glyph data, past the tables, palette and data block header
+#if QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
+    qff_unicode_glyph_v1_t unicode_glyph_cache[QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE];
+#endif // QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -36,6 +41,35 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Helper: unicode table layout
+
+static inline uint32_t qp_font_unicode_table_offset(qff_font_handle_t *font) {
+    return sizeof(qff_font_descriptor_v1_t)                                    // Skip the font descriptor
+           + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
+           + sizeof(qgf_block_header_v1_t);                                    // Skip the unicode block header
+}
+
+// Fonts generated by QMK's tooling always have the unicode table sorted by code point, others may not
+static bool qp_font_unicode_table_is_sorted(qff_font_handle_t *font) {
+    if (qp_stream_setpos(&font->stream, qp_font_unicode_table_offset(font)) < 0) {
+        return false;
+    }
+
+    qff_unicode_glyph_v1_t glyph_info;
+    uint32_t               last_code_point = 0;
+    for (uint16_t i = 0; i < font->num_unicode_glyphs; ++i) {
+        if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &font->stream) != 1) {
+            return false;
+        }
+        if (i > 0 && glyph_info.code_point <= last_code_point) {
+            return false;
+        }
+        last_code_point = glyph_info.code_point;
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -100,6 +134,17 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     // Read the info (parsing already successful above, no need to check return value)
     qff_read_font_descriptor(&font->stream, &font->base.line_height, &font->has_ascii_table, &font->num_unicode_glyphs, &font->bpp, &font->has_palette, &font->is_panel_native, &font->compression_scheme, NULL);
 
+    // Work out the layout once, rather than for every glyph
+    font->glyph_data_offset = sizeof(qff_font_descriptor_v1_t)                                                                                                              // Skip the font descriptor
+                              + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                            // Skip the ascii table
+                              + (font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                              + (font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                  // Skip the palette
+                              + sizeof(qgf_block_header_v1_t);                                                                                                              // Skip the data block header
+    font->unicode_table_sorted = qp_font_unicode_table_is_sorted(font);
+#if QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
+    memset(font->unicode_glyph_cache, 0, sizeof(font->unicode_glyph_cache));
+#endif // QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
+
     if (!qp_internal_bpp_capable(font->bpp)) {
         qp_dprintf("qp_load_font: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)font->bpp);
         qp_close_font((painter_font_handle_t)font);
@@ -112,6 +157,123 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
     return (painter_font_handle_t)font;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+STATIC_ASSERT(QUANTUM_PAINTER_GLYPH_CACHE_SIZE <= UINT16_MAX, "QUANTUM_PAINTER_GLYPH_CACHE_SIZE must be less than 64kB");
+
+typedef struct qp_glyph_cache_entry_t {
+    qff_font_handle_t *font; // NULL if unused
+    painter_device_t   device;
+    uint32_t           code_point;
+    hsv_t              fg_hsv888;
+    hsv_t              bg_hsv888;
+    uint32_t           last_used;
+    uint16_t           offset; // location in the arena
+    uint16_t           length; // bytes used in the arena
+} qp_glyph_cache_entry_t;
+
+// Glyphs are packed from the start of the arena, which is compacted on eviction
+static uint8_t                qp_glyph_cache_arena[QUANTUM_PAINTER_GLYPH_CACHE_SIZE];
+static qp_glyph_cache_entry_t qp_glyph_cache_entries[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES];
+static uint16_t               qp_glyph_cache_used  = 0;
+static uint32_t               qp_glyph_cache_clock = 0;
+
+static inline bool qp_glyph_cache_hsv_equal(hsv_t a, hsv_t b) {
+    return a.h == b.h && a.s == b.s && a.v == b.v;
+}
+
+static void qp_glyph_cache_remove(qp_glyph_cache_entry_t *entry) {
+    uint16_t end = entry->offset + entry->length;
+    memmove(&qp_glyph_cache_arena[entry->offset], &qp_glyph_cache_arena[end], qp_glyph_cache_used - end);
+    qp_glyph_cache_used -= entry->length;
+
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *other = &qp_glyph_cache_entries[i];
+        if (other->font && other->offset > entry->offset) {
+            other->offset -= entry->length;
+        }
+    }
+    entry->font = NULL;
+}
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(qff_font_handle_t *qff_font, painter_device_t device, uint32_t code_point, hsv_t fg_hsv888, hsv_t bg_hsv888) {
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &qp_glyph_cache_entries[i];
+        if (entry->font == qff_font && entry->device == device && entry->code_point == code_point && qp_glyph_cache_hsv_equal(entry->fg_hsv888, fg_hsv888) && qp_glyph_cache_hsv_equal(entry->bg_hsv888, bg_hsv888)) {
+            entry->last_used = ++qp_glyph_cache_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Reserves arena space for a new glyph, evicting the least recently used glyphs as required
+static qp_glyph_cache_entry_t *qp_glyph_cache_alloc(uint32_t length) {
+    if (length > QUANTUM_PAINTER_GLYPH_CACHE_SIZE) {
+        return NULL;
+    }
+
+    while (true) {
+        qp_glyph_cache_entry_t *free_entry = NULL;
+        qp_glyph_cache_entry_t *lru_entry  = NULL;
+        for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+            qp_glyph_cache_entry_t *entry = &qp_glyph_cache_entries[i];
+            if (!entry->font) {
+                free_entry = free_entry ? free_entry : entry;
+            } else if (!lru_entry || (qp_glyph_cache_clock - entry->last_used) > (qp_glyph_cache_clock - lru_entry->last_used)) {
+                lru_entry = entry;
+            }
+        }
+
+        if (free_entry && (QUANTUM_PAINTER_GLYPH_CACHE_SIZE - qp_glyph_cache_used) >= length) {
+            free_entry->offset    = qp_glyph_cache_used;
+            free_entry->length    = length;
+            free_entry->last_used = ++qp_glyph_cache_clock;
+            qp_glyph_cache_used += length;
+            return free_entry;
+        }
+
+        qp_glyph_cache_remove(lru_entry);
+    }
+}
+
+void qp_internal_glyph_cache_invalidate(void) {
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entries[i].font = NULL;
+    }
+    qp_glyph_cache_used = 0;
+}
+
+static void qp_glyph_cache_invalidate_font(qff_font_handle_t *qff_font) {
+    for (uint8_t i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (qp_glyph_cache_entries[i].font == qff_font) {
+            qp_glyph_cache_remove(&qp_glyph_cache_entries[i]);
+        }
+    }
+}
+
+// Output state used when rendering a glyph into the arena
+typedef struct qp_glyph_cache_output_state_t {
+    painter_device_t device;
+    uint8_t         *buffer;
+    uint32_t         pixel_write_pos;
+} qp_glyph_cache_output_state_t;
+
+static bool qp_glyph_cache_pixel_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    qp_glyph_cache_output_state_t *state  = (qp_glyph_cache_output_state_t *)cb_arg;
+    painter_driver_t              *driver = (painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->buffer, palette, state->pixel_write_pos++, 1, &index);
+}
+
+#else // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+void qp_internal_glyph_cache_invalidate(void) {}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_load_font_mem
 
@@ -151,6 +313,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // The handle gets reused by the next font loaded
+    qp_glyph_cache_invalidate_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -214,6 +381,73 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     return true;
 }
 
+// Helper that positions the stream at the glyph data described by the glyph table value
+static inline bool qp_drawtext_seek_glyph_data(qff_font_handle_t *qff_font, uint32_t glyph_value, uint8_t *width) {
+    uint8_t  glyph_width  = (uint8_t)(glyph_value & QFF_GLYPH_WIDTH_MASK);
+    uint32_t glyph_offset = ((glyph_value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    if (qp_stream_setpos(&qff_font->stream, qff_font->glyph_data_offset + glyph_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
+        return false;
+    }
+
+    *width = glyph_width;
+    return true;
+}
+
+// Helper that reads the unicode table entry at the supplied index
+static inline bool qp_drawtext_read_unicode_glyph(qff_font_handle_t *qff_font, uint16_t index, qff_unicode_glyph_v1_t *glyph_info) {
+    if (qp_stream_setpos(&qff_font->stream, qp_font_unicode_table_offset(qff_font) + index * sizeof(qff_unicode_glyph_v1_t)) < 0) {
+        qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+        return false;
+    }
+
+    if (qp_stream_read(glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
+        qp_dprintf("Failed to read unicode glyph info\n");
+        return false;
+    }
+    return true;
+}
+
+// Helper that finds the unicode table entry for the supplied code point
+static inline bool qp_drawtext_find_unicode_glyph(qff_font_handle_t *qff_font, uint32_t code_point, qff_unicode_glyph_v1_t *glyph_info) {
+    if (qff_font->unicode_table_sorted) {
+        // Binary search
+        uint16_t lo = 0;
+        uint16_t hi = qff_font->num_unicode_glyphs;
+        while (lo < hi) {
+            uint16_t mid = lo + (hi - lo) / 2;
+            if (!qp_drawtext_read_unicode_glyph(qff_font, mid, glyph_info)) {
+                return false;
+            }
+            if (glyph_info->code_point == code_point) {
+                return true;
+            }
+            if (glyph_info->code_point < code_point) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return false;
+    }
+
+    // Unsorted table, linear scan
+    if (qp_stream_setpos(&qff_font->stream, qp_font_unicode_table_offset(qff_font)) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
+        return false;
+    }
+    for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
+        if (qp_stream_read(glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
+            qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+            return false;
+        }
+        if (glyph_info->code_point == code_point) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
@@ -231,65 +465,28 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
-        return true;
+        return qp_drawtext_seek_glyph_data(qff_font, glyph_info.value, width);
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
-        uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
-                                     + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
-                                     + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
-
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing glyph data\n");
-            return false;
+#if QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
+        // Code point zero never gets here, so zeroed entries never match
+        qff_unicode_glyph_v1_t *cached = &qff_font->unicode_glyph_cache[code_point % QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE];
+        if (cached->code_point == code_point) {
+            return qp_drawtext_seek_glyph_data(qff_font, cached->value, width);
         }
+#endif // QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
 
         qff_unicode_glyph_v1_t glyph_info;
-        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
-            if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
-                qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
-                return false;
-            }
-
-            if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
-                return true;
-            }
+        if (!qp_drawtext_find_unicode_glyph(qff_font, code_point, &glyph_info)) {
+            qp_dprintf("Failed to find unicode glyph info\n");
+            return false;
         }
 
-        // Not found
-        qp_dprintf("Failed to find unicode glyph info\n");
-        return false;
+#if QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
+        *cached = glyph_info;
+#endif // QUANTUM_PAINTER_UNICODE_GLYPH_CACHE_SIZE > 0
+        return qp_drawtext_seek_glyph_data(qff_font, glyph_info.value, width);
     }
-    return false;
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
@@ -345,6 +542,9 @@ typedef struct code_point_iter_drawglyph_state_t {
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t   *input_state;
     qp_internal_pixel_output_state_t *output_state;
+    // Colors, keying the glyph cache
+    hsv_t fg_hsv888;
+    hsv_t bg_hsv888;
 } code_point_iter_drawglyph_state_t;
 
 // Codepoint handler callback: drawing
@@ -364,8 +564,38 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     // Move the x-position for the next glyph
     state->xpos += width;
 
-    // Decode the pixel data for the glyph, and stream it
     uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+    // Only palette-based glyphs need decoding, native ones are already streamed as-is
+    if (qff_font->bpp <= 8) {
+        qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(qff_font, state->device, code_point, state->fg_hsv888, state->bg_hsv888);
+        if (!entry) {
+            entry = qp_glyph_cache_alloc((pixel_count * driver->native_bits_per_pixel + 7) / 8);
+            if (entry) {
+                // Render the glyph into the arena
+                qp_glyph_cache_output_state_t output_state = {.device = state->device, .buffer = &qp_glyph_cache_arena[entry->offset], .pixel_write_pos = 0};
+                memset(output_state.buffer, 0, entry->length);
+                if (!qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_glyph_cache_pixel_appender, &output_state)) {
+                    qp_glyph_cache_remove(entry);
+                    return false;
+                }
+
+                entry->font       = qff_font;
+                entry->device     = state->device;
+                entry->code_point = code_point;
+                entry->fg_hsv888  = state->fg_hsv888;
+                entry->bg_hsv888  = state->bg_hsv888;
+            }
+        }
+
+        if (entry) {
+            return driver->driver_vtable->pixdata(state->device, &qp_glyph_cache_arena[entry->offset], pixel_count);
+        }
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_SIZE > 0
+
+    // Decode the pixel data for the glyph, and stream it
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
@@ -441,6 +671,8 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
 
     qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
     qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    state.fg_hsv888      = fg_hsv888.hsv888;
+    state.bg_hsv888      = bg_hsv888.hsv888;
     uint32_t   data_offset;
     if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
         qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
@@ -312,7 +312,13 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
     if (pointing_device_get_status() != POINTING_DEVICE_STATUS_SUCCESS) {
+#ifdef POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE
+        // scrolling from encoders doesn't need the sensor, and would otherwise build up until it recovers
+        local_mouse_report = pointing_device_scroll_apply(local_mouse_report);
+        return pointing_device_send();
+#else
         return false;
+#endif
     }
 
     // Gather report info
@@ -362,6 +368,10 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
     local_mouse_report = pointing_device_task_modules(local_mouse_report);
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
+#ifdef POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE
+    // batch up scrolling since the last report
+    local_mouse_report = pointing_device_scroll_apply(local_mouse_report);
+#endif
     // automatic mouse layer function
 #ifdef POINTING_DEVICE_AUTO_MOUSE_ENABLE
     pointing_device_task_auto_mouse(local_mouse_report);
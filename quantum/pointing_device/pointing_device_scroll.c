@@ -0,0 +1,142 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE
+
+#    include "pointing_device_scroll.h"
+#    include "keycodes.h"
+#    include "keycode.h"
+#    include "util.h"
+
+enum { SCROLL_AXIS_H, SCROLL_AXIS_V, SCROLL_AXES };
+
+/* Scroll gathered since the last report, and left over from earlier reports, both in 1/POINTING_DEVICE_SCROLL_DIVISOR of a report unit */
+static int32_t scroll_input[SCROLL_AXES];
+static int32_t scroll_remainder[SCROLL_AXES];
+
+/**
+ * @brief Gets the number of report units making up one wheel detent
+ *
+ * @return 1, or the resolution multiplier when using high resolution scrolling
+ */
+static int32_t scroll_units_per_detent(void) {
+#    ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    return pointing_device_get_hires_scroll_resolution();
+#    else
+    return 1;
+#    endif
+}
+
+/**
+ * @brief Adds whole wheel detents to be scrolled with the next report
+ *
+ * @param[in] h detents right, negative for left
+ * @param[in] v detents up, negative for down
+ */
+void pointing_device_scroll_add_detents(int8_t h, int8_t v) {
+    int32_t detent = scroll_units_per_detent() * POINTING_DEVICE_SCROLL_DIVISOR;
+    scroll_input[SCROLL_AXIS_H] += h * detent;
+    scroll_input[SCROLL_AXIS_V] += v * detent;
+}
+
+/**
+ * @brief Adds sensor motion to be scrolled with the next report
+ *
+ * Every POINTING_DEVICE_SCROLL_DIVISOR counts scroll by one detent, with anything less carried over to later reports.
+ *
+ * @param[in] h counts right, negative for left
+ * @param[in] v counts up, negative for down
+ */
+void pointing_device_scroll_add_motion(int16_t h, int16_t v) {
+    int32_t count = scroll_units_per_detent();
+    scroll_input[SCROLL_AXIS_H] += h * count;
+    scroll_input[SCROLL_AXIS_V] += v * count;
+}
+
+/**
+ * @brief Drops any scroll that hasn't been reported yet
+ */
+void pointing_device_scroll_clear(void) {
+    for (uint8_t i = 0; i < SCROLL_AXES; i++) {
+        scroll_input[i]     = 0;
+        scroll_remainder[i] = 0;
+    }
+}
+
+static mouse_hv_report_t scroll_apply_axis(uint8_t axis, mouse_hv_report_t current) {
+    int32_t input       = scroll_input[axis];
+    scroll_input[axis] = 0;
+
+#    if POINTING_DEVICE_SCROLL_ACCELERATION > 0
+    int32_t detents = (input < 0 ? -input : input) / (scroll_units_per_detent() * POINTING_DEVICE_SCROLL_DIVISOR);
+    if (detents > 1) {
+        int32_t percent = MIN(100 + POINTING_DEVICE_SCROLL_ACCELERATION * (detents - 1), POINTING_DEVICE_SCROLL_ACCELERATION_MAX);
+        input           = input * percent / 100;
+    }
+#    endif
+
+    // Leftovers from the other direction would only hold up turning back
+    int32_t total = scroll_remainder[axis];
+    if ((input > 0 && total < 0) || (input < 0 && total > 0)) {
+        total = 0;
+    }
+    total += input;
+
+    // Anything that doesn't fit in this report is carried over to the next
+    hv_clamp_range_t value = (hv_clamp_range_t)current + total / POINTING_DEVICE_SCROLL_DIVISOR;
+    if (value < MOUSE_REPORT_HV_MIN) {
+        value = MOUSE_REPORT_HV_MIN;
+    } else if (value > MOUSE_REPORT_HV_MAX) {
+        value = MOUSE_REPORT_HV_MAX;
+    }
+
+    // Keep a fast spin from scrolling on long after it has stopped
+    int32_t remainder      = total - (int32_t)(value - current) * POINTING_DEVICE_SCROLL_DIVISOR;
+    int32_t limit          = (int32_t)POINTING_DEVICE_SCROLL_CARRY_MAX * MOUSE_REPORT_HV_MAX * POINTING_DEVICE_SCROLL_DIVISOR;
+    scroll_remainder[axis] = MAX(-limit, MIN(remainder, limit));
+    return value;
+}
+
+/**
+ * @brief Adds the scroll gathered since the last report to the mouse report
+ *
+ * @param[in] mouse_report report_mouse_t
+ * @return report_mouse_t with the accumulated scroll added
+ */
+report_mouse_t pointing_device_scroll_apply(report_mouse_t mouse_report) {
+    mouse_report.h = scroll_apply_axis(SCROLL_AXIS_H, mouse_report.h);
+    mouse_report.v = scroll_apply_axis(SCROLL_AXIS_V, mouse_report.v);
+    return mouse_report;
+}
+
+/**
+ * @brief Turns mouse wheel keycodes on encoders into accumulated detents
+ *
+ * @param[in] keycode uint16_t
+ * @param[in] record keyrecord_t pointer
+ * @return false if the keycode was a mouse wheel keycode on an encoder
+ */
+bool process_pointing_device_scroll(uint16_t keycode, keyrecord_t *record) {
+    if (!IS_ENCODEREVENT(record->event) || !IS_MOUSEKEY_WHEEL(keycode)) {
+        return true;
+    }
+    if (record->event.pressed) {
+        switch (keycode) {
+            case QK_MOUSE_WHEEL_UP:
+                pointing_device_scroll_add_detents(0, 1);
+                break;
+            case QK_MOUSE_WHEEL_DOWN:
+                pointing_device_scroll_add_detents(0, -1);
+                break;
+            case QK_MOUSE_WHEEL_LEFT:
+                pointing_device_scroll_add_detents(-1, 0);
+                break;
+            case QK_MOUSE_WHEEL_RIGHT:
+                pointing_device_scroll_add_detents(1, 0);
+                break;
+        }
+    }
+    return false;
+}
+
+#endif // POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE
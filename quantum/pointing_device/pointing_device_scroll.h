@@ -0,0 +1,37 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pointing_device.h"
+#include "action.h"
+#include "report.h"
+
+#ifndef POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE
+#    error "POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE not defined! check config settings"
+#endif
+
+/* Sensor counts per wheel detent */
+#ifndef POINTING_DEVICE_SCROLL_DIVISOR
+#    define POINTING_DEVICE_SCROLL_DIVISOR 8
+#endif
+/* Extra percentage of scroll per additional detent scrolled within one report */
+#ifndef POINTING_DEVICE_SCROLL_ACCELERATION
+#    define POINTING_DEVICE_SCROLL_ACCELERATION 0
+#endif
+/* Upper limit for the scroll percentage when accelerating */
+#ifndef POINTING_DEVICE_SCROLL_ACCELERATION_MAX
+#    define POINTING_DEVICE_SCROLL_ACCELERATION_MAX 400
+#endif
+/* Number of full reports worth of scroll that may be carried over, anything beyond is dropped */
+#ifndef POINTING_DEVICE_SCROLL_CARRY_MAX
+#    define POINTING_DEVICE_SCROLL_CARRY_MAX 4
+#endif
+
+void           pointing_device_scroll_add_detents(int8_t h, int8_t v);
+void           pointing_device_scroll_add_motion(int16_t h, int16_t v);
+void           pointing_device_scroll_clear(void);
+report_mouse_t pointing_device_scroll_apply(report_mouse_t mouse_report);
+bool           process_pointing_device_scroll(uint16_t keycode, keyrecord_t *record);
@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -102,6 +103,23 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_INDEX_ENABLE
+/* Keycode to combo index, laid out as hash buckets of ascending combo indices.
+ * Bucket b holds the combos containing a keycode hashing to b, in
+ * combo_index_entries[combo_index_start[b] .. combo_index_start[b + 1]).
+ * combo_index_keys has a bit set for every keycode used by any combo, any
+ * keycode with its bit clear cannot be part of a combo. */
+#    define COMBO_INDEX_HASH(kc) (((kc) ^ ((kc) >> 8)) & (COMBO_INDEX_BUCKETS - 1))
+#    define COMBO_INDEX_KEY_BIT(kc) ((kc) & (COMBO_INDEX_KEY_BITS - 1))
+
+typedef enum { COMBO_INDEX_STALE, COMBO_INDEX_READY, COMBO_INDEX_OVERFLOW } combo_index_status_t;
+
+static combo_index_status_t combo_index_status = COMBO_INDEX_STALE;
+static uint8_t              combo_index_keys[COMBO_INDEX_KEY_BITS / 8];
+static uint16_t             combo_index_start[COMBO_INDEX_BUCKETS + 1];
+static uint16_t            *combo_index_entries;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -210,6 +228,76 @@ void clear_combos(void) {
     }
 }
 
+#ifdef COMBO_INDEX_ENABLE
+/* Calls fn for every distinct bucket the combo's keys hash to. */
+static void combo_index_for_each_bucket(combo_t *combo, void (*fn)(uint8_t bucket, uint16_t combo_index), uint16_t combo_index) {
+    uint8_t  seen[(COMBO_INDEX_BUCKETS + 7) / 8] = {0};
+    uint16_t key;
+    for (uint8_t i = 0; (key = pgm_read_word(&combo->keys[i])) != COMBO_END; ++i) {
+        uint8_t bucket = COMBO_INDEX_HASH(key);
+        if (!(seen[bucket / 8] & (1 << (bucket % 8)))) {
+            seen[bucket / 8] |= 1 << (bucket % 8);
+            fn(bucket, combo_index);
+        }
+    }
+}
+
+static void combo_index_count(uint8_t bucket, uint16_t combo_index) {
+    combo_index_start[bucket + 1]++;
+}
+
+static inline bool combo_index_has_key(uint16_t keycode) {
+    uint16_t bit = COMBO_INDEX_KEY_BIT(keycode);
+    return combo_index_keys[bit / 8] & (1 << (bit % 8));
+}
+
+static void combo_index_fill(uint8_t bucket, uint16_t combo_index) {
+    // combo_index_start[bucket] is used as the write cursor, and ends up at the start of the next bucket
+    combo_index_entries[combo_index_start[bucket]++] = combo_index;
+}
+
+static void combo_index_build(void) {
+    memset(combo_index_keys, 0, sizeof(combo_index_keys));
+    memset(combo_index_start, 0, sizeof(combo_index_start));
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        combo_t *combo = combo_get(idx);
+        uint16_t key;
+        for (uint8_t i = 0; (key = pgm_read_word(&combo->keys[i])) != COMBO_END; ++i) {
+            uint16_t bit = COMBO_INDEX_KEY_BIT(key);
+            combo_index_keys[bit / 8] |= 1 << (bit % 8);
+        }
+        combo_index_for_each_bucket(combo, combo_index_count, idx);
+    }
+    for (uint16_t bucket = 0; bucket < COMBO_INDEX_BUCKETS; ++bucket) {
+        combo_index_start[bucket + 1] += combo_index_start[bucket];
+    }
+
+    // The storage always fits the keymap's combos, only dynamically stored ones can run out of room
+    uint16_t capacity;
+    combo_index_entries = combo_index_storage(&capacity);
+    if (combo_index_start[COMBO_INDEX_BUCKETS] > capacity) {
+        // Fall back to scanning every combo, keys with no combo still skip it
+        combo_index_status = COMBO_INDEX_OVERFLOW;
+        return;
+    }
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        combo_index_for_each_bucket(combo_get(idx), combo_index_fill, idx);
+    }
+    // Each cursor now points at the following bucket's start; shift them back into place
+    for (uint16_t bucket = COMBO_INDEX_BUCKETS; bucket > 0; --bucket) {
+        combo_index_start[bucket] = combo_index_start[bucket - 1];
+    }
+    combo_index_start[0] = 0;
+    combo_index_status   = COMBO_INDEX_READY;
+}
+
+void combo_index_invalidate(void) {
+    combo_index_status = COMBO_INDEX_STALE;
+}
+#endif
+
 static inline void dump_key_buffer(void) {
     /* First call start from 0 index; recursive calls need to start from i+1 index */
     static uint8_t key_buffer_next = 0;
@@ -585,10 +673,27 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_ENABLE
+    if (combo_index_status == COMBO_INDEX_STALE) {
+        combo_index_build();
+    }
+    if (!combo_index_has_key(keycode)) {
+        // No combo contains this keycode, so none of them would change state
+    } else if (combo_index_status == COMBO_INDEX_READY) {
+        // Only combos sharing this keycode's bucket can contain it; the rest would not change state
+        uint8_t bucket = COMBO_INDEX_HASH(keycode);
+        for (uint16_t i = combo_index_start[bucket]; i < combo_index_start[bucket + 1]; ++i) {
+            uint16_t idx = combo_index_entries[i];
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -57,6 +57,23 @@ typedef struct combo_t {
 #endif
 } combo_t;
 
+#ifdef COMBO_INDEX_ENABLE
+#    ifndef COMBO_INDEX_BUCKETS
+#        define COMBO_INDEX_BUCKETS 64
+#    endif
+#    ifndef COMBO_INDEX_KEY_BITS
+#        define COMBO_INDEX_KEY_BITS 1024
+#    endif
+#    if (COMBO_INDEX_BUCKETS & (COMBO_INDEX_BUCKETS - 1)) != 0 || COMBO_INDEX_BUCKETS > 256
+#        error COMBO_INDEX_BUCKETS must be a power of two no larger than 256
+#    endif
+#    if (COMBO_INDEX_KEY_BITS & (COMBO_INDEX_KEY_BITS - 1)) != 0 || COMBO_INDEX_KEY_BITS < 8
+#        error COMBO_INDEX_KEY_BITS must be a power of two no smaller than 8
+#    endif
+/* A combo is filed under each distinct bucket its keys hash to */
+#    define COMBO_INDEX_ENTRIES_PER_COMBO (MAX_COMBO_LENGTH < COMBO_INDEX_BUCKETS ? MAX_COMBO_LENGTH : COMBO_INDEX_BUCKETS)
+#endif
+
 #define COMBO(ck, ca) {.keys = &(ck)[0], .keycode = (ca)}
 #define COMBO_ACTION(ck) {.keys = &(ck)[0]}
 
@@ -79,3 +96,8 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_INDEX_ENABLE
+/* Rebuilds the keycode to combo index on next use, call after changing combo definitions at runtime */
+void combo_index_invalidate(void);
+#endif
@@ -18,11 +18,18 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
+#include "compiler_support.h"
 #include "debug.h"
+#include "timer.h"
 #include "wait.h"
 
+#ifdef DYNAMIC_MACRO_PERSIST
+#    include "nvm_dynamic_macro.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -82,25 +89,212 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+/* Both macros use the same buffer but read/write on different
+ * ends of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ *  0            macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^                                  ^
+ *           SIZE - macro_length[1]                           SIZE
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * Each event is stored as:
+ *
+ *   flags    1 byte: bit 0 pressed, bits 1-3 event type, bit 4 tap state follows, bit 5 keycode follows
+ *   row      1 byte
+ *   col      1 byte
+ *   delta    varint, milliseconds since the previous event of the macro
+ *   tap      1 byte, optional
+ *   keycode  varint, optional
+ *
+ * where a varint holds 7 bits per byte, least significant first, with
+ * the top bit set on all but the last byte.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+STATIC_ASSERT(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must be less than 65536");
+#ifndef NO_ACTION_TAPPING
+STATIC_ASSERT(sizeof(tap_t) == 1, "tap_t is expected to fit a single byte");
+#endif
+
+#define DYNAMIC_MACRO_FLAG_PRESSED 0x01
+#define DYNAMIC_MACRO_FLAG_TYPE_SHIFT 1
+#define DYNAMIC_MACRO_FLAG_TYPE_MASK 0x07
+#define DYNAMIC_MACRO_FLAG_TAP 0x10
+#define DYNAMIC_MACRO_FLAG_KEYCODE 0x20
+
+// Flags, row and column, plus two varints of at most 3 bytes each and the tap state
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 10
+
+/* The number of bytes used by each macro. */
+static uint16_t macro_length[2] = {0, 0};
+
+/* The number of bytes recorded so far for the macro being recorded. */
+static uint16_t macro_pointer = 0;
+
+/* The time of the last event recorded, to encode the next delta against. */
+static uint16_t macro_last_time = 0;
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+#define DYNAMIC_MACRO_SLOT(direction) ((direction) > 0 ? 1 : 2)
+#define DYNAMIC_MACRO_INDEX(direction) ((direction) > 0 ? 0 : 1)
 
 #ifdef DYNAMIC_MACRO_KEEP_ORIGINAL_LAYER_STATE
 static layer_state_t dm1_layer_state;
 static layer_state_t dm2_layer_state;
 #endif
 
+static inline uint8_t *dynamic_macro_byte(int8_t direction, uint16_t offset) {
+    return direction > 0 ? &macro_buffer[offset] : &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - 1 - offset];
+}
+
+static uint8_t dynamic_macro_encode_varint(uint8_t *data, uint16_t value) {
+    uint8_t length = 0;
+    while (value >= 0x80) {
+        data[length++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    data[length++] = value;
+    return length;
+}
+
+static uint16_t dynamic_macro_decode_varint(int8_t direction, uint16_t *offset) {
+    uint16_t value = 0;
+    for (uint8_t shift = 0; shift < 16; shift += 7) {
+        uint8_t data = *dynamic_macro_byte(direction, (*offset)++);
+        value |= (uint16_t)(data & 0x7F) << shift;
+        if (!(data & 0x80)) {
+            break;
+        }
+    }
+    return value;
+}
+
+static uint8_t dynamic_macro_encode(uint8_t *data, keyrecord_t *record, uint16_t delta) {
+    uint8_t flags = (record->event.pressed ? DYNAMIC_MACRO_FLAG_PRESSED : 0) | ((record->event.type & DYNAMIC_MACRO_FLAG_TYPE_MASK) << DYNAMIC_MACRO_FLAG_TYPE_SHIFT);
+    uint8_t tap   = 0;
+#ifndef NO_ACTION_TAPPING
+    memcpy(&tap, &record->tap, sizeof(tap));
+#endif
+    if (tap) {
+        flags |= DYNAMIC_MACRO_FLAG_TAP;
+    }
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        flags |= DYNAMIC_MACRO_FLAG_KEYCODE;
+    }
+#endif
+
+    uint8_t length = 0;
+    data[length++] = flags;
+    data[length++] = record->event.key.row;
+    data[length++] = record->event.key.col;
+    length += dynamic_macro_encode_varint(&data[length], delta);
+    if (flags & DYNAMIC_MACRO_FLAG_TAP) {
+        data[length++] = tap;
+    }
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (flags & DYNAMIC_MACRO_FLAG_KEYCODE) {
+        length += dynamic_macro_encode_varint(&data[length], record->keycode);
+    }
+#endif
+    return length;
+}
+
+/**
+ * Decode a single event of a macro.
+ *
+ * @param[in]     direction Either +1 or -1, which macro to read.
+ * @param[in,out] offset    The offset of the event, advanced past it.
+ * @param[out]    record    The decoded event, with the time left unset.
+ * @return The milliseconds elapsed since the previous event.
+ */
+static uint16_t dynamic_macro_decode(int8_t direction, uint16_t *offset, keyrecord_t *record) {
+    memset(record, 0, sizeof(keyrecord_t));
+
+    uint8_t flags = *dynamic_macro_byte(direction, (*offset)++);
+
+    record->event.pressed = flags & DYNAMIC_MACRO_FLAG_PRESSED;
+    record->event.type    = (flags >> DYNAMIC_MACRO_FLAG_TYPE_SHIFT) & DYNAMIC_MACRO_FLAG_TYPE_MASK;
+    record->event.key.row = *dynamic_macro_byte(direction, (*offset)++);
+    record->event.key.col = *dynamic_macro_byte(direction, (*offset)++);
+
+    uint16_t delta = dynamic_macro_decode_varint(direction, offset);
+    if (flags & DYNAMIC_MACRO_FLAG_TAP) {
+        uint8_t tap = *dynamic_macro_byte(direction, (*offset)++);
+#ifndef NO_ACTION_TAPPING
+        memcpy(&record->tap, &tap, sizeof(tap));
+#else
+        (void)tap;
+#endif
+    }
+    if (flags & DYNAMIC_MACRO_FLAG_KEYCODE) {
+        uint16_t keycode = dynamic_macro_decode_varint(direction, offset);
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = keycode;
+#else
+        (void)keycode;
+#endif
+    }
+    return delta;
+}
+
+#ifdef DYNAMIC_MACRO_PERSIST
+static void dynamic_macro_save(int8_t direction) {
+    // Drop the macro being rewritten first, so that an interrupted write never leaves a half-written macro behind
+    if (direction > 0) {
+        nvm_dynamic_macro_update_lengths(0, macro_length[1]);
+    } else {
+        nvm_dynamic_macro_update_lengths(macro_length[0], 0);
+    }
+
+    // Both macros are written, in case the stored copy of the other one was erased since it was recorded. Unchanged
+    // bytes are skipped, so this only costs writes for the macro just recorded.
+    nvm_dynamic_macro_update_buffer(0, macro_length[0], macro_buffer);
+    nvm_dynamic_macro_update_buffer(DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1], macro_length[1], &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1]]);
+    nvm_dynamic_macro_update_lengths(macro_length[0], macro_length[1]);
+}
+#endif
+
+/**
+ * Start up with the macros saved to EEPROM, if persisting them, or with both macros empty otherwise.
+ */
+void dynamic_macro_init(void) {
+    macro_length[0] = macro_length[1] = 0;
+#ifdef DYNAMIC_MACRO_PERSIST
+    if (!nvm_dynamic_macro_read_lengths(&macro_length[0], &macro_length[1])) {
+        macro_length[0] = macro_length[1] = 0;
+        return;
+    }
+    nvm_dynamic_macro_read_buffer(0, macro_length[0], macro_buffer);
+    nvm_dynamic_macro_read_buffer(DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1], macro_length[1], &macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE - macro_length[1]]);
+#endif
+}
+
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[in] direction Either +1 or -1, which macro to record.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(int8_t direction) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_kb(direction);
@@ -115,18 +309,16 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     layer_clear();
 #endif
     clear_keyboard();
-    *macro_pointer = macro_buffer;
+    macro_pointer = 0;
 }
 
 /**
  * Play the dynamic macro.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param direction[in] Either +1 or -1, which macro to play.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+void dynamic_macro_play(int8_t direction) {
+    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_SLOT(direction));
 
     layer_state_t saved_layer_state = layer_state;
 
@@ -141,9 +333,22 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
     layer_clear();
 #endif
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
+    uint16_t    length = macro_length[DYNAMIC_MACRO_INDEX(direction)];
+    uint16_t    offset = 0;
+    uint16_t    time   = 0;
+    keyrecord_t record;
+
+    // Replayed events keep their original spacing, with the last one happening now
+    while (offset < length) {
+        time -= dynamic_macro_decode(direction, &offset, &record);
+    }
+    time += timer_read();
+
+    offset = 0;
+    while (offset < length) {
+        time += dynamic_macro_decode(direction, &offset, &record);
+        record.event.time = time;
+        process_record(&record);
 #ifdef DYNAMIC_MACRO_DELAY
         wait_ms(DYNAMIC_MACRO_DELAY);
 #endif
@@ -159,107 +364,76 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
+ * @param direction[in]  Either +1 or -1, which macro is being recorded.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && macro_pointer == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
+    uint8_t  event[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint16_t delta    = macro_pointer == 0 ? 0 : TIMER_DIFF_16(record->event.time, macro_last_time);
+    uint8_t  size     = dynamic_macro_encode(event, record, delta);
+    uint16_t capacity = DYNAMIC_MACRO_BUFFER_SIZE - macro_length[DYNAMIC_MACRO_INDEX(-direction)];
+
+    /* The other end of the other macro is the last buffer byte it
      * is safe to use before overwriting the other macro.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    if (macro_pointer + size <= capacity) {
+        for (uint8_t i = 0; i < size; i++) {
+            *dynamic_macro_byte(direction, macro_pointer++) = event[i];
+        }
+        macro_last_time = record->event.time;
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d/%d bytes\n", DYNAMIC_MACRO_SLOT(direction), macro_pointer, capacity);
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(int8_t direction) {
     dynamic_macro_record_end_kb(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    uint16_t    offset = 0;
+    uint16_t    length = 0;
+    keyrecord_t record;
+    while (offset < macro_pointer) {
+        dynamic_macro_decode(direction, &offset, &record);
+        if (!record.event.pressed) {
+            length = offset;
+        }
+    }
+    if (length != macro_pointer) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", DYNAMIC_MACRO_SLOT(direction), length);
 
-    *macro_end = macro_pointer;
+    macro_length[DYNAMIC_MACRO_INDEX(direction)] = length;
+#ifdef DYNAMIC_MACRO_PERSIST
+    dynamic_macro_save(direction);
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
- */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
-
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
-
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
-
 /**
  * If a dynamic macro is currently being recorded, stop recording.
  */
 void dynamic_macro_stop_recording(void) {
     switch (macro_id) {
         case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
+            dynamic_macro_record_end(+1);
             break;
         case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
+            dynamic_macro_record_end(-1);
             break;
     }
     macro_id = 0;
@@ -273,18 +447,18 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
+                    dynamic_macro_record_start(+1);
                     macro_id = 1;
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
+                    dynamic_macro_record_start(-1);
                     macro_id = 2;
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(+1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(-1);
                     return false;
             }
         }
@@ -312,10 +486,10 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
                     /* Store the key in the macro buffer and process it normally. */
                     switch (macro_id) {
                         case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
+                            dynamic_macro_record_key(+1, record);
                             break;
                         case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
+                            dynamic_macro_record_key(-1, record);
                             break;
                     }
                 }
@@ -35,6 +35,16 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Events are stored in a compact variable length format, usually
+ * 4-5 bytes each. By default the buffer takes up the same amount of RAM
+ * as DYNAMIC_MACRO_SIZE uncompressed key records would, and so holds
+ * several times as many events.
+ */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
+void dynamic_macro_init(void);
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -93,6 +93,10 @@
 #    include "process_oneshot.h"
 #endif
 
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifdef DEFAULT_LAYER_SONGS
 float default_layer_songs[][16][2] = DEFAULT_LAYER_SONGS;
@@ -217,6 +221,16 @@ void shutdown_quantum(bool jump_to_bootloader) {
     audio_shutdown();
 #endif
 
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_flush();
+#endif
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_flush();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+    wear_leveling_consolidate_finish();
+#endif
+
     shutdown_modules(jump_to_bootloader);
     shutdown_kb(jump_to_bootloader);
 
@@ -419,6 +433,9 @@ bool process_record_quantum(keyrecord_t *record) {
 #ifdef JOYSTICK_ENABLE
             process_joystick(keycode, record) &&
 #endif
+#if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE)
+            process_pointing_device_scroll(keycode, record) &&
+#endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
             process_programmable_button(keycode, record) &&
 #endif
@@ -475,6 +492,17 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 }
 
 void suspend_power_down_quantum(void) {
+    // The host may cut power while suspended
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_flush();
+#endif
+#ifdef EECONFIG_WRITE_BEHIND
+    eeconfig_flush();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_BACKGROUND_CONSOLIDATION)
+    // Housekeeping stops while suspended, so don't leave a consolidation half done
+    wear_leveling_consolidate_finish();
+#endif
     suspend_power_down_modules();
     suspend_power_down_kb();
 #ifndef NO_SUSPEND_POWER_DOWN
@@ -8,6 +8,8 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
     uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    // LEDs without a hit all look the same
+    rgb_t background = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, scale16by8(max_tick, qadd8(rgb_matrix_config.speed, 1))));
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
@@ -19,8 +21,11 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
             }
         }
 
-        uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
-        rgb_t    rgb    = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
+        rgb_t rgb = background;
+        if (tick < max_tick) {
+            uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
+            rgb             = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
+        }
         rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
     return rgb_matrix_check_finished_leds(led_max);
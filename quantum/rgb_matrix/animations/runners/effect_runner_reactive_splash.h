@@ -3,6 +3,33 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// Returns how far a hit reaches at the given tick: LEDs at this distance or further away are left untouched
+typedef uint16_t (*reactive_splash_reach_f)(uint16_t tick);
+
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_TABLE
+// Distance between two LEDs, looked up in the lower triangle generated from g_led_config.point
+static inline uint8_t effect_runner_splash_distance(uint8_t a, uint8_t b) {
+    if (a == b) {
+        return 0;
+    }
+    if (a < b) {
+        uint8_t t = a;
+        a         = b;
+        b         = t;
+    }
+    return pgm_read_byte(&g_rgb_matrix_splash_distance[(uint16_t)a * (a - 1) / 2 + b]);
+}
+#    endif
+
+static inline uint8_t effect_runner_splash_hit_distance(uint8_t i, uint8_t j) {
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_TABLE
+    return effect_runner_splash_distance(i, g_last_hit_tracker.index[j]);
+#    else
+    int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+    int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+    return sqrt16(dx * dx + dy * dy);
+#    endif
+}
 
 bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
@@ -15,7 +42,7 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
         for (uint8_t j = start; j < count; j++) {
             int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
             int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
+            uint8_t  dist = effect_runner_splash_hit_distance(i, j);
             uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
             hsv           = effect_func(hsv, dx, dy, dist, tick);
         }
@@ -26,4 +53,54 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+// Same as effect_runner_reactive_splash(), but LEDs out of reach of every hit are set dark without running the effect
+bool effect_runner_reactive_splash_sparse(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t  count  = g_last_hit_tracker.count;
+    bool     active = false;
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    uint16_t reach[LED_HITS_TO_REMEMBER];
+    for (uint8_t j = start; j < count; j++) {
+        tick[j]  = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        reach[j] = reach_func(tick[j]);
+        active |= reach[j] > 0;
+    }
+
+    hsv_t hsv  = rgb_matrix_config.hsv;
+    hsv.v      = 0;
+    rgb_t dark = rgb_matrix_hsv_to_rgb(hsv);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        uint8_t dist[LED_HITS_TO_REMEMBER];
+        bool    lit = false;
+        for (uint8_t j = start; j < count && active; j++) {
+            if (reach[j] > 0) {
+                dist[j] = effect_runner_splash_hit_distance(i, j);
+                lit |= dist[j] < reach[j];
+            }
+        }
+        if (!lit) {
+            rgb_matrix_set_color(i, dark.r, dark.g, dark.b);
+            continue;
+        }
+
+        // Hits out of reach still get to run, as some effects shift the hue regardless
+        hsv   = rgb_matrix_config.hsv;
+        hsv.v = 0;
+        for (uint8_t j = start; j < count; j++) {
+            int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            if (reach[j] == 0) {
+                dist[j] = effect_runner_splash_hit_distance(i, j);
+            }
+            hsv = effect_func(hsv, dx, dy, dist[j], tick[j]);
+        }
+        hsv.v     = scale8(hsv.v, rgb_matrix_config.hsv.v);
+        rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
+        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+    }
+    return rgb_matrix_check_finished_leds(led_max);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -28,6 +28,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#if defined(RGB_MATRIX_RENDER_BUDGET_ENABLED) && defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -71,6 +75,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+led_polar_t g_rgb_matrix_polar[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_POLAR_EFFECTS
 
 #ifndef RGB_MATRIX_FLAG_STEPS
 #    define RGB_MATRIX_FLAG_STEPS {LED_FLAG_ALL, LED_FLAG_KEYLIGHT | LED_FLAG_MODIFIER, LED_FLAG_UNDERGLOW, LED_FLAG_NONE}
@@ -97,6 +104,33 @@ static last_hit_t last_hit_buffer;
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_ENABLED
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#        define RGB_RENDER_LED_LIMIT_DEFAULT RGB_MATRIX_LED_PROCESS_LIMIT
+#    else
+#        define RGB_RENDER_LED_LIMIT_DEFAULT RGB_MATRIX_LED_COUNT
+#    endif
+
+typedef struct rgb_render_cost_t {
+    uint32_t frames;
+    uint32_t render_us;
+} rgb_render_cost_t;
+
+// LEDs covered by the current render iteration
+static uint8_t rgb_render_led_min = 0;
+static uint8_t rgb_render_led_max = 0;
+// LEDs per render iteration, adapted to the measured cost of the current effect
+static uint8_t rgb_render_led_limit = RGB_RENDER_LED_LIMIT_DEFAULT;
+// Moving average of the render time per LED, in 1/16th of a microsecond
+static uint16_t rgb_render_led_cost = 0;
+static uint32_t rgb_render_frame_us = 0;
+
+static rgb_render_cost_t rgb_render_costs[RGB_MATRIX_EFFECT_MAX];
+static uint16_t          rgb_render_fps        = 0;
+static uint16_t          rgb_render_fps_frames = 0;
+static uint32_t          rgb_render_fps_timer  = 0;
+#endif // RGB_MATRIX_RENDER_BUDGET_ENABLED
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, rgb_matrix_config);
 
 void eeconfig_force_flush_rgb_matrix(void) {
@@ -327,6 +361,107 @@ static void rgb_task_start(void) {
     rgb_task_state = RENDERING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_ENABLED
+__attribute__((weak)) uint32_t rgb_matrix_render_timer_us(void) {
+#    if defined(PROTOCOL_CHIBIOS)
+    // Accumulate tick deltas so that a 16 bit system timer wrapping doesn't skew measurements
+    static systime_t last_ticks = 0;
+    static uint32_t  elapsed_us = 0;
+    systime_t        now        = chVTGetSystemTimeX();
+    elapsed_us += TIME_I2US(chTimeDiffX(last_ticks, now));
+    last_ticks = now;
+    return elapsed_us;
+#    else
+    return timer_read32() * 1000;
+#    endif
+}
+
+static void rgb_render_budget_start(void) {
+    if (rgb_effect_params.iter == 0) {
+        if (rgb_effect_params.init) {
+            // New effect, forget the cost of the previous one
+            rgb_render_led_limit = RGB_RENDER_LED_LIMIT_DEFAULT;
+            rgb_render_led_cost  = 0;
+        }
+#    if defined(RGB_MATRIX_SPLIT)
+        rgb_render_led_min = is_keyboard_left() ? 0 : k_rgb_matrix_split[0];
+#    else
+        rgb_render_led_min = 0;
+#    endif
+        rgb_render_frame_us = 0;
+    } else {
+        rgb_render_led_min = rgb_render_led_max;
+    }
+
+#    if defined(RGB_MATRIX_SPLIT)
+    uint8_t led_end = is_keyboard_left() ? k_rgb_matrix_split[0] : RGB_MATRIX_LED_COUNT;
+#    else
+    uint8_t led_end = RGB_MATRIX_LED_COUNT;
+#    endif
+    rgb_render_led_max = MIN((uint16_t)rgb_render_led_min + rgb_render_led_limit, led_end);
+}
+
+static void rgb_render_budget_end(uint32_t elapsed_us) {
+    rgb_render_frame_us += elapsed_us;
+
+    uint8_t led_count = rgb_render_led_max - rgb_render_led_min;
+    if (led_count == 0) {
+        return;
+    }
+
+    uint32_t sample = MIN((elapsed_us << 4) / led_count, UINT16_MAX);
+    if (rgb_render_led_cost == 0) {
+        rgb_render_led_cost = sample;
+    } else {
+        rgb_render_led_cost = (int32_t)rgb_render_led_cost + ((int32_t)sample - (int32_t)rgb_render_led_cost) / 4;
+    }
+
+    // Size the next iteration so that it fits within the budget, but always make progress
+    uint32_t limit       = rgb_render_led_cost ? ((uint32_t)RGB_MATRIX_RENDER_BUDGET_US << 4) / rgb_render_led_cost : RGB_MATRIX_LED_COUNT;
+    rgb_render_led_limit = MAX(MIN(limit, RGB_MATRIX_LED_COUNT), 1);
+}
+
+static void rgb_render_budget_frame(uint8_t effect) {
+    if (effect < RGB_MATRIX_EFFECT_MAX) {
+        rgb_render_cost_t *cost = &rgb_render_costs[effect];
+        if (cost->render_us > UINT32_MAX / 2) {
+            cost->render_us /= 2;
+            cost->frames /= 2;
+        }
+        cost->frames++;
+        cost->render_us += rgb_render_frame_us;
+    }
+
+    rgb_render_fps_frames++;
+    uint32_t elapsed = timer_elapsed32(rgb_render_fps_timer);
+    if (elapsed >= 1000) {
+        rgb_render_fps        = (uint32_t)rgb_render_fps_frames * 1000 / elapsed;
+        rgb_render_fps_frames = 0;
+        rgb_render_fps_timer  = timer_read32();
+    }
+}
+
+uint16_t rgb_matrix_get_fps(void) {
+    return rgb_render_fps;
+}
+
+bool rgb_matrix_get_render_stats(uint8_t mode, rgb_matrix_render_stats_t *stats) {
+    if (mode >= RGB_MATRIX_EFFECT_MAX) {
+        return false;
+    }
+    stats->frames        = rgb_render_costs[mode].frames;
+    stats->avg_render_us = stats->frames ? rgb_render_costs[mode].render_us / stats->frames : 0;
+    return true;
+}
+
+void rgb_matrix_reset_render_stats(void) {
+    memset(rgb_render_costs, 0, sizeof(rgb_render_costs));
+    rgb_render_fps        = 0;
+    rgb_render_fps_frames = 0;
+    rgb_render_fps_timer  = timer_read32();
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_ENABLED
+
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
@@ -335,6 +470,11 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_ENABLED
+    rgb_render_budget_start();
+    uint32_t render_start = rgb_matrix_render_timer_us();
+#endif
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -384,6 +524,10 @@ static void rgb_task_render(uint8_t effect) {
             return;
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_ENABLED
+    rgb_render_budget_end(rgb_matrix_render_timer_us() - render_start);
+#endif
+
     rgb_effect_params.iter++;
 
     // next task
@@ -404,6 +548,10 @@ static void rgb_task_flush(uint8_t effect) {
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_ENABLED
+    rgb_render_budget_frame(effect);
+#endif
+
     // next task
     rgb_task_state = SYNCING;
 }
@@ -454,7 +602,12 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_RENDER_BUDGET_ENABLED)
+    // Iterations are sized as they go, so the bounds of the current one are tracked instead
+    (void)iter;
+    limits.led_min_index = rgb_render_led_min;
+    limits.led_max_index = rgb_render_led_max;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -503,8 +656,20 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+void rgb_matrix_update_polar_cache(void) {
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx                  = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy                  = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        g_rgb_matrix_polar[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_rgb_matrix_polar[i].angle = atan2_8(dy, dx);
+    }
+#endif // RGB_MATRIX_POLAR_EFFECTS
+}
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_update_polar_cache();
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -179,6 +179,7 @@ bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
+void rgb_matrix_update_polar_cache(void);
 
 void rgb_matrix_reload_from_eeprom(void);
 
@@ -236,6 +237,35 @@ void        rgb_matrix_update_pwm_buffers(void);
 const char *rgb_matrix_get_mode_name(uint8_t mode);
 #endif // RGB_MATRIX_MODE_NAME_ENABLE
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_ENABLED
+typedef struct rgb_matrix_render_stats_t {
+    uint32_t frames;
+    uint32_t avg_render_us;
+} rgb_matrix_render_stats_t;
+
+/**
+ * @brief Free-running microsecond counter used to budget rendering
+ *
+ * Weakly defined; the default resolution is the ChibiOS system tick, or one
+ * millisecond on other platforms.
+ */
+uint32_t rgb_matrix_render_timer_us(void);
+
+/**
+ * @brief Frames flushed to the driver during the last full second
+ */
+uint16_t rgb_matrix_get_fps(void);
+
+/**
+ * @brief Number of frames and average time spent rendering a frame of an effect
+ *
+ * @return false if the effect does not exist
+ */
+bool rgb_matrix_get_render_stats(uint8_t mode, rgb_matrix_render_stats_t *stats);
+
+void rgb_matrix_reset_render_stats(void);
+#endif // RGB_MATRIX_RENDER_BUDGET_ENABLED
+
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_force_flush_rgb_matrix
 #    define rgblight_reload_from_eeprom rgb_matrix_reload_from_eeprom
@@ -298,6 +328,12 @@ extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+#    ifdef RGB_MATRIX_SPLASH_DISTANCE_TABLE
+extern const uint8_t g_rgb_matrix_splash_distance[];
+#    endif
+#endif
+#ifdef RGB_MATRIX_POLAR_EFFECTS
+extern led_polar_t g_rgb_matrix_polar[RGB_MATRIX_LED_COUNT];
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
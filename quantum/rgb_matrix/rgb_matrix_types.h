@@ -27,6 +27,10 @@
 #    define RGB_MATRIX_KEYREACTIVE_ENABLED
 #endif
 
+#if defined(RGB_MATRIX_RENDER_BUDGET_US) && RGB_MATRIX_RENDER_BUDGET_US > 0
+#    define RGB_MATRIX_RENDER_BUDGET_ENABLED
+#endif
+
 // Last led hit
 #ifndef LED_HITS_TO_REMEMBER
 #    define LED_HITS_TO_REMEMBER 8
@@ -57,6 +61,11 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+typedef struct PACKED {
+    uint8_t dist;  // distance from the center
+    uint8_t angle; // angle around the center, 0-255 for a full turn
+} led_polar_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -0,0 +1,183 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "scan_profiler.h"
+#include "bitwise.h"
+#include "timer.h"
+#include "util.h"
+#include "print.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+// Bucket 0 holds zero-length measurements, bucket n holds measurements in [2^(n-1), 2^n)
+#define SCAN_PROFILER_BUCKETS 33
+
+typedef struct scan_profiler_stats_t {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t histogram[SCAN_PROFILER_BUCKETS];
+} scan_profiler_stats_t;
+
+static scan_profiler_stats_t scan_profiler_stats[SCAN_PROFILER_STAGE_COUNT];
+
+static const char *const scan_profiler_stage_names[SCAN_PROFILER_STAGE_COUNT] = {
+    [SCAN_PROFILER_STAGE_KEYBOARD_TASK]   = "keyboard_task",
+    [SCAN_PROFILER_STAGE_MATRIX]          = "matrix_task",
+    [SCAN_PROFILER_STAGE_QUANTUM]         = "quantum_task",
+    [SCAN_PROFILER_STAGE_RGBLIGHT]        = "rgblight_task",
+    [SCAN_PROFILER_STAGE_LED_MATRIX]      = "led_matrix_task",
+    [SCAN_PROFILER_STAGE_RGB_MATRIX]      = "rgb_matrix_task",
+    [SCAN_PROFILER_STAGE_ENCODER]         = "encoder_task",
+    [SCAN_PROFILER_STAGE_POINTING_DEVICE] = "pointing_device_task",
+    [SCAN_PROFILER_STAGE_OLED]            = "oled_task",
+    [SCAN_PROFILER_STAGE_HOUSEKEEPING]    = "housekeeping_task",
+};
+
+__attribute__((weak)) uint32_t scan_profiler_read_cycles(void) {
+#if defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE)
+    return chSysGetRealtimeCounterX();
+#else
+    return timer_read32();
+#endif
+}
+
+static inline uint8_t scan_profiler_bucket(uint32_t cycles) {
+    return cycles ? biton32(cycles) + 1 : 0;
+}
+
+static void scan_profiler_reset_stage(scan_profiler_stage_t stage) {
+    memset(&scan_profiler_stats[stage], 0, sizeof(scan_profiler_stats_t));
+    scan_profiler_stats[stage].min = UINT32_MAX;
+}
+
+void scan_profiler_reset(void) {
+    for (uint8_t stage = 0; stage < SCAN_PROFILER_STAGE_COUNT; stage++) {
+        scan_profiler_reset_stage(stage);
+    }
+}
+
+void scan_profiler_record(scan_profiler_stage_t stage, uint32_t cycles) {
+    if (stage >= SCAN_PROFILER_STAGE_COUNT) {
+        return;
+    }
+
+    scan_profiler_stats_t *stats = &scan_profiler_stats[stage];
+    if (stats->count == 0) {
+        // Statics start zeroed, make sure the first measurement always sets the minimum
+        stats->min = UINT32_MAX;
+    }
+    if (stats->count < UINT32_MAX) {
+        stats->count++;
+        stats->sum += cycles;
+    }
+    stats->min = MIN(stats->min, cycles);
+    stats->max = MAX(stats->max, cycles);
+
+    uint16_t *bucket = &stats->histogram[scan_profiler_bucket(cycles)];
+    if (*bucket == UINT16_MAX) {
+        // Halve the whole histogram rather than saturate, keeping the distribution intact
+        for (uint8_t i = 0; i < SCAN_PROFILER_BUCKETS; i++) {
+            stats->histogram[i] /= 2;
+        }
+    }
+    (*bucket)++;
+}
+
+bool scan_profiler_get_summary(scan_profiler_stage_t stage, scan_profiler_summary_t *summary) {
+    if (stage >= SCAN_PROFILER_STAGE_COUNT) {
+        return false;
+    }
+
+    const scan_profiler_stats_t *stats = &scan_profiler_stats[stage];
+    memset(summary, 0, sizeof(scan_profiler_summary_t));
+    if (stats->count == 0) {
+        return true;
+    }
+
+    summary->count = stats->count;
+    summary->min   = stats->min;
+    summary->max   = stats->max;
+    summary->avg   = (uint32_t)(stats->sum / stats->count);
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < SCAN_PROFILER_BUCKETS; i++) {
+        total += stats->histogram[i];
+    }
+
+    // Report the upper bound of the bucket holding the 99th percentile, capped to the exact maximum
+    uint32_t target     = total - total / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < SCAN_PROFILER_BUCKETS; i++) {
+        cumulative += stats->histogram[i];
+        if (cumulative >= target) {
+            uint32_t upper = i == 0 ? 0 : (i >= 32 ? UINT32_MAX : (1UL << i) - 1);
+            summary->p99   = MIN(upper, stats->max);
+            break;
+        }
+    }
+    return true;
+}
+
+const char *scan_profiler_stage_name(scan_profiler_stage_t stage) {
+    return stage < SCAN_PROFILER_STAGE_COUNT ? scan_profiler_stage_names[stage] : "unknown";
+}
+
+void scan_profiler_print(void) {
+    xprintf("scan profiler (cycles): count/min/avg/max/p99\n");
+    for (uint8_t stage = 0; stage < SCAN_PROFILER_STAGE_COUNT; stage++) {
+        scan_profiler_summary_t summary;
+        if (scan_profiler_get_summary(stage, &summary) && summary.count > 0) {
+            xprintf("  %-20s %lu/%lu/%lu/%lu/%lu\n", scan_profiler_stage_name(stage), (unsigned long)summary.count, (unsigned long)summary.min, (unsigned long)summary.avg, (unsigned long)summary.max, (unsigned long)summary.p99);
+        }
+    }
+}
+
+void scan_profiler_task(void) {
+#if SCAN_PROFILER_REPORT_INTERVAL > 0
+    static uint32_t last_report = 0;
+    if (timer_elapsed32(last_report) >= SCAN_PROFILER_REPORT_INTERVAL) {
+        last_report = timer_read32();
+        scan_profiler_print();
+        scan_profiler_reset();
+    }
+#endif
+}
+
+static void scan_profiler_write_u32(uint8_t *dest, uint32_t value) {
+    dest[0] = value & 0xFF;
+    dest[1] = (value >> 8) & 0xFF;
+    dest[2] = (value >> 16) & 0xFF;
+    dest[3] = (value >> 24) & 0xFF;
+}
+
+bool scan_profiler_raw_hid_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, stage, flags/status, count, min, avg, max, p99 ]
+    if (length < 23 || data[0] != SCAN_PROFILER_RAW_HID_ID) {
+        return false;
+    }
+
+    scan_profiler_stage_t   stage = data[1];
+    bool                    reset = data[2] & 0x01;
+    scan_profiler_summary_t summary;
+
+    if (!scan_profiler_get_summary(stage, &summary)) {
+        data[2] = 1;
+        return true;
+    }
+    if (reset) {
+        scan_profiler_reset_stage(stage);
+    }
+
+    data[2] = 0;
+    scan_profiler_write_u32(&data[3], summary.count);
+    scan_profiler_write_u32(&data[7], summary.min);
+    scan_profiler_write_u32(&data[11], summary.avg);
+    scan_profiler_write_u32(&data[15], summary.max);
+    scan_profiler_write_u32(&data[19], summary.p99);
+    return true;
+}
@@ -0,0 +1,120 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Scan loop profiler.
+
+    Measures how long each stage of keyboard_task() takes, keeping min/avg/max and a
+    log2 histogram (used to estimate the 99th percentile) per stage. Enable with
+    `SCAN_PROFILER_ENABLE = yes` in rules.mk.
+
+    Results are printed over console every SCAN_PROFILER_REPORT_INTERVAL milliseconds,
+    and can be queried over raw HID through scan_profiler_raw_hid_command().
+
+    Additional code can be measured against a stage with:
+
+        SCAN_PROFILE(SCAN_PROFILER_STAGE_HOUSEKEEPING, my_expensive_call());
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SCAN_PROFILER_REPORT_INTERVAL
+#    define SCAN_PROFILER_REPORT_INTERVAL 5000
+#endif
+
+#ifndef SCAN_PROFILER_RAW_HID_ID
+#    define SCAN_PROFILER_RAW_HID_ID 0xB0
+#endif
+
+typedef enum scan_profiler_stage_t {
+    SCAN_PROFILER_STAGE_KEYBOARD_TASK,
+    SCAN_PROFILER_STAGE_MATRIX,
+    SCAN_PROFILER_STAGE_QUANTUM,
+    SCAN_PROFILER_STAGE_RGBLIGHT,
+    SCAN_PROFILER_STAGE_LED_MATRIX,
+    SCAN_PROFILER_STAGE_RGB_MATRIX,
+    SCAN_PROFILER_STAGE_ENCODER,
+    SCAN_PROFILER_STAGE_POINTING_DEVICE,
+    SCAN_PROFILER_STAGE_OLED,
+    SCAN_PROFILER_STAGE_HOUSEKEEPING,
+    SCAN_PROFILER_STAGE_COUNT,
+} scan_profiler_stage_t;
+
+typedef struct scan_profiler_summary_t {
+    uint32_t count;
+    uint32_t min;
+    uint32_t avg;
+    uint32_t max;
+    uint32_t p99;
+} scan_profiler_summary_t;
+
+#ifdef SCAN_PROFILER_ENABLE
+
+/**
+ * @brief Reads the free-running cycle counter used for measurements.
+ *
+ * Defaults to the realtime counter on ChibiOS ports supporting it, and the millisecond timer
+ * elsewhere. Weakly defined so that boards (and unit tests) can provide their own source.
+ */
+uint32_t scan_profiler_read_cycles(void);
+
+/**
+ * @brief Records one measurement against a stage.
+ */
+void scan_profiler_record(scan_profiler_stage_t stage, uint32_t cycles);
+
+/**
+ * @brief Summarises the measurements of a stage since the last reset.
+ *
+ * @return false if the stage is invalid
+ */
+bool scan_profiler_get_summary(scan_profiler_stage_t stage, scan_profiler_summary_t *summary);
+
+/**
+ * @brief Returns a printable name for the stage.
+ */
+const char *scan_profiler_stage_name(scan_profiler_stage_t stage);
+
+/**
+ * @brief Discards all measurements.
+ */
+void scan_profiler_reset(void);
+
+/**
+ * @brief Prints all stages with measurements over console.
+ */
+void scan_profiler_print(void);
+
+/**
+ * @brief Prints and resets the measurements every SCAN_PROFILER_REPORT_INTERVAL milliseconds.
+ */
+void scan_profiler_task(void);
+
+/**
+ * @brief Handles a scan profiler raw HID request in place.
+ *
+ * Request:  [ SCAN_PROFILER_RAW_HID_ID, stage, flags ], flags bit 0 resets the stage after reading.
+ * Response: [ SCAN_PROFILER_RAW_HID_ID, stage, status, count, min, avg, max, p99 ], values as
+ * little-endian uint32_t, status is 0 on success.
+ *
+ * @return true if the packet was a scan profiler request, and the response should be sent
+ */
+bool scan_profiler_raw_hid_command(uint8_t *data, uint8_t length);
+
+#    define SCAN_PROFILE(stage, ...)                                                          \
+        do {                                                                                  \
+            uint32_t scan_profile_start = scan_profiler_read_cycles();                        \
+            __VA_ARGS__;                                                                      \
+            scan_profiler_record((stage), scan_profiler_read_cycles() - scan_profile_start); \
+        } while (0)
+
+#else
+
+#    define SCAN_PROFILE(stage, ...) \
+        do {                         \
+            __VA_ARGS__;             \
+        } while (0)
+
+#endif // SCAN_PROFILER_ENABLE
@@ -146,50 +146,354 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include <string.h>
+#    include "deferred_exec.h"
+#    include "timer.h"
+#    include "util.h"
+
+_Static_assert(SEND_STRING_ASYNC_BUFFER_SIZE >= 16 && SEND_STRING_ASYNC_BUFFER_SIZE <= 255, "SEND_STRING_ASYNC_BUFFER_SIZE must be between 16 and 255");
+_Static_assert(SEND_STRING_ASYNC_TEXT_SIZE >= 16 && SEND_STRING_ASYNC_TEXT_SIZE <= UINT16_MAX, "SEND_STRING_ASYNC_TEXT_SIZE must be between 16 and 65535");
+_Static_assert(SEND_STRING_ASYNC_MAX_STRINGS >= 1 && SEND_STRING_ASYNC_MAX_STRINGS <= 255, "SEND_STRING_ASYNC_MAX_STRINGS must be between 1 and 255");
+
+// Worst case number of events decoded from a single character: shift, altgr, the key itself and a dead key space
+#    define SEND_STRING_ASYNC_MAX_EVENTS_PER_CHAR 8
+
+typedef enum send_string_async_op_t {
+    SEND_STRING_ASYNC_REGISTER,
+    SEND_STRING_ASYNC_UNREGISTER,
+    SEND_STRING_ASYNC_WAIT,
+    SEND_STRING_ASYNC_BELL,
+} send_string_async_op_t;
+
+typedef struct send_string_async_event_t {
+    uint8_t  op;
+    uint8_t  keycode;
+    uint32_t delay; // milliseconds to wait after performing the operation
+} send_string_async_event_t;
+
+// A string waiting to be decoded, either read on demand from its getter, or copied into the text buffer
+typedef struct send_string_async_source_t {
+    char (*getter)(void *);
+    void    *arg;
+    uint16_t length; // bytes of the text buffer still belonging to this string
+    uint8_t  interval;
+} send_string_async_source_t;
+
+static send_string_async_event_t send_string_async_queue[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint8_t                   send_string_async_tail       = 0;
+static uint8_t                   send_string_async_count      = 0;
+static uint32_t                  send_string_async_ready      = 0;
+static bool                      send_string_async_enqueueing = false;
+
+static send_string_async_source_t send_string_async_sources[SEND_STRING_ASYNC_MAX_STRINGS];
+static uint8_t                    send_string_async_source_tail  = 0;
+static uint8_t                    send_string_async_source_count = 0;
+
+static char     send_string_async_text[SEND_STRING_ASYNC_TEXT_SIZE];
+static uint16_t send_string_async_text_tail  = 0;
+static uint16_t send_string_async_text_count = 0;
+
+// Keys pressed by performed events and not yet released, one bit per basic keycode
+static uint8_t send_string_async_held[256 / 8];
+
+static deferred_executor_t send_string_async_executors[1] = {0};
+static deferred_token      send_string_async_token        = INVALID_DEFERRED_TOKEN;
+static uint32_t            send_string_async_last_exec    = 0;
+
+static uint32_t send_string_async_callback(uint32_t trigger_time, void *cb_arg);
+static bool     send_string_decode_next(char (*getter)(void *), void *arg, uint8_t interval);
+
+static void send_string_async_perform(void) {
+    send_string_async_event_t event = send_string_async_queue[send_string_async_tail];
+    send_string_async_tail          = (send_string_async_tail + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    send_string_async_count--;
+
+    switch (event.op) {
+        case SEND_STRING_ASYNC_REGISTER:
+            send_string_async_held[event.keycode / 8] |= 1 << (event.keycode % 8);
+            register_code(event.keycode);
+            break;
+        case SEND_STRING_ASYNC_UNREGISTER:
+            send_string_async_held[event.keycode / 8] &= ~(1 << (event.keycode % 8));
+            unregister_code(event.keycode);
+            break;
+        case SEND_STRING_ASYNC_BELL:
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+            PLAY_SONG(bell_song);
+#    endif
+            break;
+        default:
+            break;
+    }
+
+    // Every operation changes the report, so give the host at least one polling interval before the next one
+    send_string_async_ready = timer_read32() + MAX(event.delay, 1);
+}
+
+// Only called while refilling, which guarantees room for a whole character's worth of events
+static void send_string_async_push(send_string_async_op_t op, uint8_t keycode) {
+    send_string_async_event_t *event = &send_string_async_queue[(send_string_async_tail + send_string_async_count) % SEND_STRING_ASYNC_BUFFER_SIZE];
+    event->op                        = op;
+    event->keycode                   = keycode;
+    event->delay                     = 0;
+    send_string_async_count++;
+
+    if (send_string_async_token == INVALID_DEFERRED_TOKEN) {
+        send_string_async_token = defer_exec_advanced(send_string_async_executors, ARRAY_SIZE(send_string_async_executors), 1, send_string_async_callback, NULL);
+    }
+}
+
+static void send_string_async_delay(uint32_t ms) {
+    if (ms == 0) {
+        return;
+    }
+    if (send_string_async_count == 0) {
+        send_string_async_push(SEND_STRING_ASYNC_WAIT, 0);
+    }
+    send_string_async_event_t *event = &send_string_async_queue[(send_string_async_tail + send_string_async_count - 1) % SEND_STRING_ASYNC_BUFFER_SIZE];
+    event->delay += MIN(ms, UINT32_MAX - event->delay);
+}
+
+static char send_string_async_text_getter(void *arg) {
+    uint16_t *length = (uint16_t *)arg;
+    if (*length == 0) {
+        return 0;
+    }
+    char ret                    = send_string_async_text[send_string_async_text_tail];
+    send_string_async_text_tail = (send_string_async_text_tail + 1) % SEND_STRING_ASYNC_TEXT_SIZE;
+    send_string_async_text_count--;
+    (*length)--;
+    return ret;
+}
+
+static send_string_async_source_t *send_string_async_add_source(char (*getter)(void *), void *arg, uint8_t interval) {
+    send_string_async_source_t *source = &send_string_async_sources[(send_string_async_source_tail + send_string_async_source_count) % SEND_STRING_ASYNC_MAX_STRINGS];
+    source->getter                     = getter;
+    source->arg                        = arg;
+    source->length                     = 0;
+    source->interval                   = interval;
+    send_string_async_source_count++;
+    return source;
+}
+
+static void send_string_async_next_source(void) {
+    // Drop whatever the decoder left unread, so the next string starts at its own first byte
+    send_string_async_source_t *source = &send_string_async_sources[send_string_async_source_tail];
+    send_string_async_text_tail        = (send_string_async_text_tail + source->length) % SEND_STRING_ASYNC_TEXT_SIZE;
+    send_string_async_text_count -= source->length;
+    send_string_async_source_tail = (send_string_async_source_tail + 1) % SEND_STRING_ASYNC_MAX_STRINGS;
+    send_string_async_source_count--;
+}
+
+// Decodes queued strings for as long as the event queue has room for another character
+static void send_string_async_refill(void) {
+    bool was_enqueueing          = send_string_async_enqueueing;
+    send_string_async_enqueueing = true;
+    while (send_string_async_source_count > 0 && SEND_STRING_ASYNC_BUFFER_SIZE - send_string_async_count >= SEND_STRING_ASYNC_MAX_EVENTS_PER_CHAR) {
+        send_string_async_source_t *source = &send_string_async_sources[send_string_async_source_tail];
+        if (!send_string_decode_next(source->getter, source->arg, source->interval)) {
+            send_string_async_next_source();
+        }
+    }
+    send_string_async_enqueueing = was_enqueueing;
+}
+
+// Copies the string into the text buffer, queueing nothing unless all of it fits
+static bool send_string_async_queue_text(char (*getter)(void *), void *arg, uint8_t interval) {
+    if (send_string_async_source_count == SEND_STRING_ASYNC_MAX_STRINGS) {
+        return false;
+    }
+
+    uint16_t head   = (send_string_async_text_tail + send_string_async_text_count) % SEND_STRING_ASYNC_TEXT_SIZE;
+    uint16_t length = 0;
+    char     ascii_code;
+    while ((ascii_code = getter(arg)) != 0) {
+        if (send_string_async_text_count + length == SEND_STRING_ASYNC_TEXT_SIZE) {
+            return false;
+        }
+        send_string_async_text[(head + length) % SEND_STRING_ASYNC_TEXT_SIZE] = ascii_code;
+        length++;
+    }
+    if (length == 0) {
+        return true;
+    }
+
+    send_string_async_text_count += length;
+    send_string_async_source_t *source = send_string_async_add_source(send_string_async_text_getter, NULL, interval);
+    source->arg                        = &source->length;
+    source->length                     = length;
+    send_string_async_refill();
+    return true;
+}
+
+static uint32_t send_string_async_callback(uint32_t trigger_time, void *cb_arg) {
+    int32_t remaining = TIMER_DIFF_32(send_string_async_ready, timer_read32());
+    if (remaining > 0) {
+        return remaining;
+    }
+
+    send_string_async_refill();
+    if (send_string_async_count == 0) {
+        send_string_async_token = INVALID_DEFERRED_TOKEN;
+        return 0;
+    }
+
+    send_string_async_perform();
+    return TIMER_DIFF_32(send_string_async_ready, timer_read32());
+}
+
+bool send_string_async_busy(void) {
+    // The executor keeps running until the delay after the last event has passed
+    return send_string_async_token != INVALID_DEFERRED_TOKEN;
+}
+
+void send_string_async_flush(void) {
+    while (send_string_async_busy()) {
+        wait_ms(1);
+        send_string_async_task();
+    }
+}
+
+void send_string_async_cancel(void) {
+    send_string_async_tail         = 0;
+    send_string_async_count        = 0;
+    send_string_async_source_tail  = 0;
+    send_string_async_source_count = 0;
+    send_string_async_text_tail    = 0;
+    send_string_async_text_count   = 0;
+
+    // Release anything the sent strings left held down
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (send_string_async_held[keycode / 8] & (1 << (keycode % 8))) {
+            unregister_code(keycode);
+        }
+    }
+    memset(send_string_async_held, 0, sizeof(send_string_async_held));
+
+    cancel_deferred_exec_advanced(send_string_async_executors, ARRAY_SIZE(send_string_async_executors), send_string_async_token);
+    send_string_async_token     = INVALID_DEFERRED_TOKEN;
+    send_string_async_ready     = timer_read32();
+    send_string_async_last_exec = send_string_async_ready;
+}
+
+void send_string_async_task(void) {
+    deferred_exec_advanced_task(send_string_async_executors, ARRAY_SIZE(send_string_async_executors), &send_string_async_last_exec);
+}
+#endif // SEND_STRING_ASYNC_ENABLE
+
+// The primitives below either act immediately, or append to the asynchronous queue while a string is being decoded into it.
+// Immediate actions first flush any queued asynchronous output so that ordering is preserved.
+
+static void send_string_register(uint8_t keycode) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    if (send_string_async_enqueueing) {
+        send_string_async_push(SEND_STRING_ASYNC_REGISTER, keycode);
+        return;
+    }
+    send_string_async_flush();
+#endif
+    register_code(keycode);
+}
+
+static void send_string_unregister(uint8_t keycode) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    if (send_string_async_enqueueing) {
+        send_string_async_push(SEND_STRING_ASYNC_UNREGISTER, keycode);
+        return;
+    }
+    send_string_async_flush();
+#endif
+    unregister_code(keycode);
+}
+
+static void send_string_tap_delay(uint8_t keycode, uint16_t delay) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    if (send_string_async_enqueueing) {
+        send_string_async_push(SEND_STRING_ASYNC_REGISTER, keycode);
+        send_string_async_delay(delay);
+        send_string_async_push(SEND_STRING_ASYNC_UNREGISTER, keycode);
+        return;
+    }
+    send_string_async_flush();
+#endif
+    tap_code_delay(keycode, delay);
+}
+
+static void send_string_tap(uint8_t keycode) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    if (send_string_async_enqueueing) {
+        send_string_tap_delay(keycode, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+        return;
+    }
+    send_string_async_flush();
+#endif
+    tap_code(keycode);
+}
+
+static void send_string_wait(uint32_t ms) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    if (send_string_async_enqueueing) {
+        send_string_async_delay(ms);
+        return;
+    }
+#endif
+    wait_ms(ms);
+}
+
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
-void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
-    while (1) {
-        char ascii_code = getter(arg);
-        if (!ascii_code) break;
-        if (ascii_code == SS_QMK_PREFIX) {
+// Decodes and sends the next character or special sequence, returning false once the end of the string is reached.
+static bool send_string_decode_next(char (*getter)(void *), void *arg, uint8_t interval) {
+    char ascii_code = getter(arg);
+    if (!ascii_code) return false;
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = getter(arg);
+
+        if (ascii_code == SS_TAP_CODE) {
+            // tap
+            uint8_t keycode = getter(arg);
+            send_string_tap(keycode);
+        } else if (ascii_code == SS_DOWN_CODE) {
+            // down
+            uint8_t keycode = getter(arg);
+            send_string_register(keycode);
+        } else if (ascii_code == SS_UP_CODE) {
+            // up
+            uint8_t keycode = getter(arg);
+            send_string_unregister(keycode);
+        } else if (ascii_code == SS_DELAY_CODE) {
+            // delay
+            int ms     = 0;
             ascii_code = getter(arg);
 
-            if (ascii_code == SS_TAP_CODE) {
-                // tap
-                uint8_t keycode = getter(arg);
-                tap_code(keycode);
-            } else if (ascii_code == SS_DOWN_CODE) {
-                // down
-                uint8_t keycode = getter(arg);
-                register_code(keycode);
-            } else if (ascii_code == SS_UP_CODE) {
-                // up
-                uint8_t keycode = getter(arg);
-                unregister_code(keycode);
-            } else if (ascii_code == SS_DELAY_CODE) {
-                // delay
-                int ms     = 0;
+            while (isdigit(ascii_code)) {
+                ms *= 10;
+                ms += ascii_code - '0';
                 ascii_code = getter(arg);
+            }
 
-                while (isdigit(ascii_code)) {
-                    ms *= 10;
-                    ms += ascii_code - '0';
-                    ascii_code = getter(arg);
-                }
+            send_string_wait(ms);
+        }
 
-                wait_ms(ms);
-            }
+        send_string_wait(interval);
 
-            wait_ms(interval);
+        // if we had a delay that terminated with a null, we're done
+        return ascii_code != 0;
+    }
 
-            // if we had a delay that terminated with a null, we're done
-            if (ascii_code == 0) break;
-        } else {
-            send_char_with_delay(ascii_code, interval);
-        }
+    send_char_with_delay(ascii_code, interval);
+    return true;
+}
+
+void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Blocking calls type out anything queued first, so that they have finished by the time they return
+    send_string_async_flush();
+#endif
+    while (send_string_decode_next(getter, arg, interval)) {
     }
 }
 
@@ -209,6 +513,31 @@ void send_string_with_delay(const char *string, uint8_t interval) {
     send_string_with_delay_impl(send_string_get_next_ram, &state, interval);
 }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+bool send_string_async(const char *string) {
+    return send_string_with_delay_async(string, TAP_CODE_DELAY);
+}
+
+bool send_string_with_delay_async(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_with_delay_async_impl(send_string_get_next_ram, &state, interval);
+}
+
+bool send_string_with_delay_async_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+    return send_string_async_queue_text(getter, arg, interval);
+}
+
+bool send_string_with_delay_async_stream(char (*getter)(void *), void *arg, uint8_t interval) {
+    if (send_string_async_source_count == SEND_STRING_ASYNC_MAX_STRINGS) {
+        return false;
+    }
+
+    send_string_async_add_source(getter, arg, interval);
+    send_string_async_refill();
+    return true;
+}
+#endif // SEND_STRING_ASYNC_ENABLE
+
 void send_char(char ascii_code) {
     send_char_with_delay(ascii_code, TAP_CODE_DELAY);
 }
@@ -216,6 +545,13 @@ void send_char(char ascii_code) {
 void send_char_with_delay(char ascii_code, uint8_t interval) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') { // BEL
+#    ifdef SEND_STRING_ASYNC_ENABLE
+        if (send_string_async_enqueueing) {
+            send_string_async_push(SEND_STRING_ASYNC_BELL, 0);
+            return;
+        }
+        send_string_async_flush();
+#    endif
         PLAY_SONG(bell_song);
         return;
     }
@@ -227,31 +563,31 @@ void send_char_with_delay(char ascii_code, uint8_t interval) {
     bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
 
     if (is_shifted) {
-        register_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_register(KC_LEFT_SHIFT);
+        send_string_wait(interval);
     }
 
     if (is_altgred) {
-        register_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_register(KC_RIGHT_ALT);
+        send_string_wait(interval);
     }
 
-    tap_code_delay(keycode, interval);
-    wait_ms(interval);
+    send_string_tap_delay(keycode, interval);
+    send_string_wait(interval);
 
     if (is_altgred) {
-        unregister_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_unregister(KC_RIGHT_ALT);
+        send_string_wait(interval);
     }
 
     if (is_shifted) {
-        unregister_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_unregister(KC_LEFT_SHIFT);
+        send_string_wait(interval);
     }
 
     if (is_dead) {
-        tap_code(KC_SPACE);
-        wait_ms(interval);
+        send_string_tap(KC_SPACE);
+        send_string_wait(interval);
     }
 }
 
@@ -329,4 +665,11 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     send_string_memory_state_t state = {string};
     send_string_with_delay_impl(send_string_get_next_progmem, &state, interval);
 }
+
+#    ifdef SEND_STRING_ASYNC_ENABLE
+bool send_string_with_delay_async_P(const char *string, uint8_t interval) {
+    send_string_memory_state_t state = {string};
+    return send_string_with_delay_async_impl(send_string_get_next_progmem, &state, interval);
+}
+#    endif
 #endif
@@ -24,10 +24,23 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
 
+#ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#    define SEND_STRING_ASYNC_BUFFER_SIZE 32
+#endif
+
+#ifndef SEND_STRING_ASYNC_TEXT_SIZE
+#    define SEND_STRING_ASYNC_TEXT_SIZE 64
+#endif
+
+#ifndef SEND_STRING_ASYNC_MAX_STRINGS
+#    define SEND_STRING_ASYNC_MAX_STRINGS 4
+#endif
+
 // Look-Up Tables (LUTs) to convert ASCII character to keycode sequence.
 extern const uint8_t ascii_to_shift_lut[16];
 extern const uint8_t ascii_to_altgr_lut[16];
@@ -169,4 +182,85 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a string of ASCII characters without blocking.
+ *
+ * This function simply calls `send_string_with_delay_async(string, TAP_CODE_DELAY)`.
+ *
+ * \param string The string to type out.
+ *
+ * \return false if the string could not be queued.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Type out a string of ASCII characters without blocking, with a delay between each character.
+ *
+ * The string is copied before returning, so it does not need to outlive the call, and is typed out from the main loop
+ * after any output already queued, at most one report per millisecond. If it does not fit in the remaining
+ * `SEND_STRING_ASYNC_TEXT_SIZE` bytes, or `SEND_STRING_ASYNC_MAX_STRINGS` strings are already queued, nothing is sent.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ *
+ * \return false if the string could not be queued.
+ */
+bool send_string_with_delay_async(const char *string, uint8_t interval);
+
+/**
+ * \brief Asynchronous counterpart of `send_string_with_delay_impl()`; the string is fully read before returning.
+ */
+bool send_string_with_delay_async_impl(char (*getter)(void *), void *arg, uint8_t interval);
+
+/**
+ * \brief Asynchronous send of a string read on demand.
+ *
+ * Unlike `send_string_with_delay_async_impl()`, the getter is only invoked as the queue drains, so the length of the
+ * string is not limited. `arg` and the underlying string must remain valid until `send_string_async_busy()` returns
+ * false, or `send_string_async_cancel()` is called.
+ *
+ * \return false if `SEND_STRING_ASYNC_MAX_STRINGS` strings are already queued.
+ */
+bool send_string_with_delay_async_stream(char (*getter)(void *), void *arg, uint8_t interval);
+
+/**
+ * \brief Returns true while asynchronously sent strings have not been completely typed out.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Blocks until all asynchronously sent strings have been typed out.
+ *
+ * Synchronous send_string calls do this first, so that output is never interleaved.
+ */
+void send_string_async_flush(void);
+
+/**
+ * \brief Discards any asynchronously queued output, releasing every key that already sent output left held down.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Sends queued output. Should not be invoked by keyboard/user code.
+ */
+void send_string_async_task(void);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a PROGMEM string of ASCII characters without blocking, with a delay between each character.
+ *
+ * On ARM devices, this function is simply an alias for send_string_with_delay_async(string, interval).
+ */
+bool send_string_with_delay_async_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_with_delay_async_P(string, interval) send_string_with_delay_async(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_with_delay_async_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_with_delay_async_P(PSTR(string), 0)
+#endif // SEND_STRING_ASYNC_ENABLE
+
 /** \} */
@@ -0,0 +1,16 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 2
+
+#define SPLIT_KEYBOARD
+#define SPLIT_TRANSPORT_BATCH
+#define SPLIT_LED_STATE_ENABLE
+
+#define FORCED_SYNC_THROTTLE_MS 100
+
+#define NUM_ENCODERS_LEFT 1
+#define NUM_ENCODERS_RIGHT 1
@@ -0,0 +1,10 @@
+transactions_batch_DEFS := -DENCODER_ENABLE
+transactions_batch_INC := $(QUANTUM_PATH)/split_common
+transactions_batch_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+transactions_batch_SRC := \
+	$(PLATFORM_PATH)/timer.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/tests/transactions_batch_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c
@@ -0,0 +1,214 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <string.h>
+#include <vector>
+
+extern "C" {
+#include "transactions.h"
+#include "transport.h"
+#include "transaction_id_define.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+// Each half gets its own copy of the shared memory, swapped in while the slave runs
+static split_shared_memory_t master_memory;
+static split_shared_memory_t slave_memory;
+extern "C" split_shared_memory_t *const split_shmem = &master_memory;
+
+static std::vector<int8_t> transactions;
+static bool                fail_batches   = false;
+static uint8_t             host_leds      = 0;
+static uint8_t             slave_events   = 0;
+static int                 pending_events = 0;
+static int                 queued_events  = 0;
+static int                 drained_events = 0;
+
+static void run_as_slave(void (*fn)(void)) {
+    std::swap(master_memory, slave_memory);
+    fn();
+    std::swap(master_memory, slave_memory);
+}
+
+static void copy_to_slave(uint16_t offset, uint16_t length) {
+    memcpy((uint8_t *)&slave_memory + offset, (uint8_t *)&master_memory + offset, length);
+}
+
+static void copy_to_master(uint16_t offset, uint16_t length) {
+    memcpy((uint8_t *)&master_memory + offset, (uint8_t *)&slave_memory + offset, length);
+}
+
+static int8_t current_id;
+
+static void run_slave_callback(void) {
+    split_transaction_desc_t *trans = &split_transaction_table[current_id];
+    trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+}
+
+extern "C" bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    transactions.push_back(id);
+    if (fail_batches && id == XFER_BATCH) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        uint16_t len = std::min<uint16_t>(trans->initiator2target_buffer_size, initiator2target_length);
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+        copy_to_slave(trans->initiator2target_offset, len);
+    }
+    if (trans->slave_callback) {
+        current_id = id;
+        run_as_slave(run_slave_callback);
+    }
+    if (target2initiator_length > 0) {
+        uint16_t len = std::min<uint16_t>(trans->target2initiator_buffer_size, target2initiator_length);
+        copy_to_master(trans->target2initiator_offset, len);
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+    return true;
+}
+
+extern "C" {
+bool is_transport_connected(void) {
+    return false;
+}
+
+uint8_t host_keyboard_leds(void) {
+    return host_leds;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {}
+
+uint32_t sync_timer_read32(void) {
+    return timer_read32();
+}
+
+void sync_timer_update(uint32_t time) {}
+
+void encoder_retrieve_events(encoder_events_t *events) {
+    memset(events, 0, sizeof(*events));
+    events->enqueued = slave_events;
+}
+
+bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
+    if (pending_events == 0) {
+        return false;
+    }
+    pending_events--;
+    *index     = 1;
+    *clockwise = true;
+    return true;
+}
+
+bool encoder_queue_event(uint8_t index, bool clockwise) {
+    queued_events++;
+    return true;
+}
+
+void encoder_signal_queue_drain(void) {
+    drained_events += queued_events;
+    queued_events = 0;
+}
+}
+
+static matrix_row_t master_matrix[MATRIX_ROWS / 2];
+static matrix_row_t slave_matrix[MATRIX_ROWS / 2];
+
+static void slave_scan(void) {
+    transactions_slave(master_matrix, slave_matrix);
+}
+
+class TransactionsBatch : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        fail_batches   = false;
+        pending_events = 0;
+        queued_events  = 0;
+        drained_events = 0;
+        // Let every forced resync and failure backoff from previous tests run out
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        scan();
+        transactions.clear();
+    }
+
+    void scan(void) {
+        run_as_slave(slave_scan);
+        transactions_master(master_matrix, slave_matrix);
+    }
+
+    bool sent(int8_t id) {
+        return std::find(transactions.begin(), transactions.end(), id) != transactions.end();
+    }
+};
+
+TEST_F(TransactionsBatch, EncoderDrainIsSentRightAway) {
+    // The slave reports a detent, which the master picks up from this scan's batch
+    slave_events++;
+    pending_events = 1;
+    scan();
+
+    // Deferring the drain would let the slave send the same detent again
+    EXPECT_TRUE(sent(CMD_ENCODER_DRAIN));
+    EXPECT_EQ(drained_events, 1);
+}
+
+TEST_F(TransactionsBatch, SyncTimerIsSentRightAway) {
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    scan();
+
+    EXPECT_TRUE(sent(PUT_SYNC_TIMER));
+    EXPECT_EQ(slave_memory.sync_timer, master_memory.sync_timer);
+    EXPECT_GE(slave_memory.sync_timer, timer_read32());
+}
+
+TEST_F(TransactionsBatch, UpdatesAreQueuedForTheNextBatch) {
+    host_leds++;
+    scan();
+    EXPECT_FALSE(sent(PUT_LED_STATE));
+    EXPECT_NE(slave_memory.led_state, host_leds);
+
+    advance_time(1);
+    scan();
+    EXPECT_FALSE(sent(PUT_LED_STATE));
+    EXPECT_EQ(slave_memory.led_state, host_leds);
+}
+
+TEST_F(TransactionsBatch, FailedBatchIsRetried) {
+    host_leds++;
+    scan();
+
+    // The update was queued, and is still owed to the slave after the batch carrying it fails
+    fail_batches = true;
+    advance_time(1);
+    scan();
+    EXPECT_NE(slave_memory.led_state, host_leds);
+
+    // Once the failure backoff is over, the next batch carries it
+    fail_batches = false;
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    transactions.clear();
+    scan();
+    EXPECT_FALSE(sent(PUT_LED_STATE));
+    EXPECT_EQ(slave_memory.led_state, host_leds);
+}
+
+TEST_F(TransactionsBatch, UpdatesDuringFailureBackoffAreSentDirectly) {
+    fail_batches = true;
+    advance_time(1);
+    scan();
+
+    fail_batches = false;
+    host_leds++;
+    advance_time(1);
+    transactions.clear();
+    scan();
+    EXPECT_TRUE(sent(PUT_LED_STATE));
+    EXPECT_FALSE(sent(XFER_BATCH));
+    EXPECT_EQ(slave_memory.led_state, host_leds);
+}
@@ -103,6 +103,10 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#if defined(SPLIT_TRANSPORT_BATCH)
+    XFER_BATCH,
+#endif // defined(SPLIT_TRANSPORT_BATCH)
+
 #if defined(SPLIT_TRANSACTION_RPC)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
@@ -20,6 +20,8 @@
 
 #include "crc.h"
 #include "debug.h"
+#include "util.h"
+#include "compiler_support.h"
 #include "matrix.h"
 #include "host.h"
 #include "action_util.h"
@@ -81,9 +83,17 @@
 
 #define trans_initiator2target_cb(cb) {0, 0, 0, 0, cb}
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#if defined(SPLIT_TRANSPORT_BATCH)
+// Queues the transaction into the batch sent on the next scan whenever possible
+static bool batch_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transport_execute_split_transaction batch_execute_transaction
+#else // defined(SPLIT_TRANSPORT_BATCH)
+#    define transport_execute_split_transaction transport_execute_transaction
+#endif // defined(SPLIT_TRANSPORT_BATCH)
+
+#define transport_write(id, data, length) transport_execute_split_transaction(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transport_execute_split_transaction(id, NULL, 0, data, length)
+#define transport_exec(id) transport_execute_split_transaction(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_RPC)
 // Forward-declare the RPC callback handlers
@@ -172,14 +182,366 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Batched transport
+
+#if defined(SPLIT_TRANSPORT_BATCH)
+
+STATIC_ASSERT(SPLIT_TRANSPORT_BATCH_SIZE <= 252, "SPLIT_TRANSPORT_BATCH_SIZE too large for a single transaction");
+STATIC_ASSERT(NUM_TOTAL_TRANSACTIONS <= 32, "Too many split transactions to batch");
+
+// Each record starts with a transaction ID, its top bits giving the record type:
+//   BATCH_RECORD_DELTA: [id] [offset] [length] [data...] -- a span of the transaction buffer
+//   BATCH_RECORD_FULL:  [id] [data...]                   -- the whole transaction buffer
+#    define BATCH_RECORD_DELTA 0x00
+#    define BATCH_RECORD_FULL 0x80
+#    define BATCH_RECORD_TYPE_MASK 0xC0
+#    define BATCH_RECORD_ID_MASK 0x1F
+
+#    define BATCH_FLAG_FULL_SYNC 0x01 // master to slave: send all slave buffers, not just the changed ones
+#    define BATCH_FLAG_TRUNCATED 0x02 // slave to master: some changed buffers did not fit
+#    define BATCH_FLAG_REJECTED 0x04  // slave to master: the request was malformed and ignored
+
+static bool                batch_active         = false;
+static bool                batch_full_sync      = true;
+static bool                batch_failed         = false;
+static uint32_t            batch_last_failure   = 0;
+static uint32_t            batch_last_full_sync = 0;
+static split_batch_frame_t batch_request;
+static uint32_t            batch_request_ids; // transactions carried by the request
+// Span of each master buffer not yet acknowledged by the slave, sent with the next batch.
+// On the master, the buffer itself always holds the latest data; an empty span is clean.
+static uint8_t batch_dirty_first[NUM_TOTAL_TRANSACTIONS];
+static uint8_t batch_dirty_last[NUM_TOTAL_TRANSACTIONS];
+
+static uint8_t batch_checksum(const split_batch_frame_t *frame) {
+    // flags, length and data are contiguous
+    return crc8(&frame->flags, 2 + frame->length);
+}
+
+static bool batch_frame_valid(const split_batch_frame_t *frame) {
+    return frame->length <= SPLIT_TRANSPORT_BATCH_SIZE && frame->checksum == batch_checksum(frame);
+}
+
+static bool batch_is_batchable(int8_t id) {
+    if (id == XFER_BATCH) {
+        return false;
+    }
+#    ifndef DISABLE_SYNC_TIMER
+    // The slave's clock is set from the value, so it can't wait for the next scan
+    if (id == PUT_SYNC_TIMER) {
+        return false;
+    }
+#    endif // DISABLE_SYNC_TIMER
+#    if defined(SPLIT_TRANSACTION_RPC)
+    // RPC relies on its transactions running in sequence, right away
+    if (id >= PUT_RPC_INFO && id <= GET_RPC_RESP_DATA) {
+        return false;
+    }
+#    endif // defined(SPLIT_TRANSACTION_RPC)
+    return true;
+}
+
+static bool batch_apply(const split_batch_frame_t *frame, bool target2initiator, bool run_callbacks) {
+    uint8_t pos = 0;
+    while (pos < frame->length) {
+        uint8_t type = frame->data[pos] & BATCH_RECORD_TYPE_MASK;
+        int8_t  id   = frame->data[pos] & BATCH_RECORD_ID_MASK;
+        pos++;
+        if (id >= NUM_TOTAL_TRANSACTIONS) {
+            return false;
+        }
+
+        split_transaction_desc_t *trans  = &split_transaction_table[id];
+        uint8_t                   size   = target2initiator ? trans->target2initiator_buffer_size : trans->initiator2target_buffer_size;
+        uint8_t                  *buffer = target2initiator ? split_trans_target2initiator_buffer(trans) : split_trans_initiator2target_buffer(trans);
+        uint8_t                   offset = 0;
+        uint8_t                   length = 0;
+        switch (type) {
+            case BATCH_RECORD_DELTA:
+                if (pos + 2 > frame->length) {
+                    return false;
+                }
+                offset = frame->data[pos++];
+                length = frame->data[pos++];
+                break;
+            case BATCH_RECORD_FULL:
+                length = size;
+                break;
+            default:
+                return false;
+        }
+        if (offset + length > size || pos + length > frame->length) {
+            return false;
+        }
+
+        memcpy(buffer + offset, &frame->data[pos], length);
+        pos += length;
+
+        if (run_callbacks && trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+    return true;
+}
+
+static uint8_t batch_record_size(int8_t id) {
+    uint8_t first = batch_dirty_first[id];
+    uint8_t last  = batch_dirty_last[id];
+    if (last == 0) {
+        return 0;
+    }
+    if (first == 0 && last == split_transaction_table[id].initiator2target_buffer_size) {
+        return 1 + last;
+    }
+    return 3 + last - first;
+}
+
+static uint16_t batch_queued_size(void) {
+    uint16_t total = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        total += batch_record_size(id);
+    }
+    return total;
+}
+
+static bool batch_queue(int8_t id, const uint8_t *data, uint8_t length) {
+    split_transaction_desc_t *trans  = &split_transaction_table[id];
+    uint8_t                  *buffer = split_trans_initiator2target_buffer(trans);
+    uint8_t                   size   = trans->initiator2target_buffer_size;
+
+    // Only send the span that differs from the latest queued data, which the slave has
+    // outside of the span still pending. Unchanged data is a forced resync, send it all.
+    length        = MIN(length, size);
+    uint8_t first = 0;
+    uint8_t last  = length;
+    while (first < length && data[first] == buffer[first]) {
+        first++;
+    }
+    while (last > first && data[last - 1] == buffer[last - 1]) {
+        last--;
+    }
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    // The slave clears the change flags in place, so its copy can't be relied upon
+    if (id == PUT_RGBLIGHT) {
+        first = last = 0;
+    }
+#    endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    if (first == last) {
+        first = 0;
+        last  = length;
+    }
+
+    uint8_t  prev_first = batch_dirty_first[id];
+    uint8_t  prev_last  = batch_dirty_last[id];
+    uint16_t others     = batch_queued_size() - batch_record_size(id);
+    if (prev_last != 0) {
+        first = MIN(first, prev_first);
+        last  = MAX(last, prev_last);
+    }
+    batch_dirty_first[id] = first;
+    batch_dirty_last[id]  = last;
+    if (others + batch_record_size(id) > SPLIT_TRANSPORT_BATCH_SIZE) {
+        batch_dirty_first[id] = prev_first;
+        batch_dirty_last[id]  = prev_last;
+        return false;
+    }
+
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    // The slave only acts on the change flags, keep those it hasn't received yet
+    if (id == PUT_RGBLIGHT && prev_last != 0) {
+        uint8_t change_flags = split_shmem->rgblight_sync.status.change_flags;
+        memcpy(buffer, data, length);
+        split_shmem->rgblight_sync.status.change_flags |= change_flags;
+        return true;
+    }
+#    endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    memcpy(buffer, data, length);
+    return true;
+}
+
+static bool batch_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    // Transactions without data only run a slave callback, which can't wait for the next scan
+    if (batch_active && batch_is_batchable(id) && (initiator2target_length > 0) != (target2initiator_length > 0)) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (target2initiator_length > 0) {
+            // Already received at the start of this scan
+            memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), MIN(target2initiator_length, trans->target2initiator_buffer_size));
+            return true;
+        }
+        if (batch_queue(id, initiator2target_buf, initiator2target_length)) {
+            return true;
+        }
+        // Doesn't fit in the batch, fall back to its own transaction
+    }
+    if (!transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length)) {
+        return false;
+    }
+    if (initiator2target_length > 0) {
+        // The slave now has the whole buffer, including anything still queued
+        batch_dirty_last[id] = 0;
+    }
+    return true;
+}
+
+static void batch_build_request(void) {
+    batch_request.length = 0;
+    batch_request_ids    = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        uint8_t size = batch_record_size(id);
+        if (size == 0 || batch_request.length + size > SPLIT_TRANSPORT_BATCH_SIZE) {
+            continue;
+        }
+
+        const uint8_t *buffer = split_trans_initiator2target_buffer(&split_transaction_table[id]);
+        uint8_t        first  = batch_dirty_first[id];
+        uint8_t        span   = batch_dirty_last[id] - first;
+        uint8_t       *out    = &batch_request.data[batch_request.length];
+        if (size == 1 + span) {
+            out[0] = BATCH_RECORD_FULL | id;
+            memcpy(&out[1], buffer, span);
+        } else {
+            out[0] = BATCH_RECORD_DELTA | id;
+            out[1] = first;
+            out[2] = span;
+            memcpy(&out[3], &buffer[first], span);
+        }
+        batch_request.length += size;
+        batch_request_ids |= (uint32_t)1 << id;
+    }
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_frame_t response;
+    if (!transport_execute_transaction(XFER_BATCH, &batch_request, sizeof(batch_request), &response, sizeof(response))) {
+        return false;
+    }
+    if (!batch_frame_valid(&response) || (response.flags & BATCH_FLAG_REJECTED)) {
+        return false;
+    }
+    if (!batch_apply(&response, true, false)) {
+        return false;
+    }
+
+    // With buffers missing, reads this scan go through their own transactions
+    batch_active = !(response.flags & BATCH_FLAG_TRUNCATED);
+    return true;
+}
+
+static void batch_handlers_slave(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static uint32_t sent_valid = 0;
+    static uint8_t  sent_checksums[NUM_TOTAL_TRANSACTIONS];
+
+    const split_batch_frame_t *request  = &split_shmem->batch_m2s;
+    split_batch_frame_t       *response = &split_shmem->batch_s2m;
+    response->flags                     = 0;
+    response->length                    = 0;
+
+    if (!batch_frame_valid(request) || !batch_apply(request, false, true)) {
+        response->flags = BATCH_FLAG_REJECTED;
+    } else {
+        if (request->flags & BATCH_FLAG_FULL_SYNC) {
+            sent_valid = 0;
+        }
+
+        // Send back every slave buffer that changed since it was last sent
+        for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            uint8_t                   size  = trans->target2initiator_buffer_size;
+            if (size == 0 || !batch_is_batchable(id)) {
+                continue;
+            }
+
+            uint8_t *buffer   = split_trans_target2initiator_buffer(trans);
+            uint8_t  checksum = crc8(buffer, size);
+            if ((sent_valid & ((uint32_t)1 << id)) && sent_checksums[id] == checksum) {
+                continue;
+            }
+            if (response->length + 1 + size > SPLIT_TRANSPORT_BATCH_SIZE) {
+                response->flags |= BATCH_FLAG_TRUNCATED;
+                continue;
+            }
+
+            response->data[response->length] = BATCH_RECORD_FULL | id;
+            memcpy(&response->data[response->length + 1], buffer, size);
+            response->length += 1 + size;
+
+            sent_checksums[id] = checksum;
+            sent_valid |= (uint32_t)1 << id;
+        }
+    }
+
+    response->checksum = batch_checksum(response);
+}
+
+static void batch_begin(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    batch_active = false;
+    if (batch_failed && timer_elapsed32(batch_last_failure) < FORCED_SYNC_THROTTLE_MS) {
+        // Don't keep paying for failed batches, e.g. if the slave doesn't support them.
+        // Updates go through their own transactions meanwhile, anything queued stays queued.
+        return;
+    }
+
+    if (timer_elapsed32(batch_last_full_sync) >= FORCED_SYNC_THROTTLE_MS) {
+        batch_full_sync = true;
+    }
+    batch_build_request();
+    batch_request.flags    = batch_full_sync ? BATCH_FLAG_FULL_SYNC : 0;
+    batch_request.checksum = batch_checksum(&batch_request);
+
+    if (!transaction_handler_master(master_matrix, slave_matrix, "batch", &batch_handlers_master)) {
+        // Keep the queued spans, they're sent again with the next batch
+        batch_failed       = true;
+        batch_last_failure = timer_read32();
+        batch_full_sync    = true;
+        return;
+    }
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        if (batch_request_ids & ((uint32_t)1 << id)) {
+            batch_dirty_last[id] = 0;
+        }
+    }
+    batch_failed = false;
+    if (batch_full_sync) {
+        batch_full_sync      = false;
+        batch_last_full_sync = timer_read32();
+    }
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_MASTER() batch_begin(master_matrix, slave_matrix)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [XFER_BATCH] = {sizeof_member(split_shared_memory_t, batch_m2s), offsetof(split_shared_memory_t, batch_m2s), sizeof_member(split_shared_memory_t, batch_s2m), offsetof(split_shared_memory_t, batch_s2m), batch_handlers_slave},
+// clang-format on
+
+#else // defined(SPLIT_TRANSPORT_BATCH)
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // defined(SPLIT_TRANSPORT_BATCH)
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#if defined(SPLIT_SLAVE_MATRIX_PUSH) && (defined(USE_I2C) || !defined(SERIAL_DRIVER_USART) || !defined(SERIAL_USART_FULL_DUPLEX))
+#    error "SPLIT_SLAVE_MATRIX_PUSH requires the full-duplex usart serial driver"
+#endif
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
 
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+    // The slave notifies us of changes, only poll it to recover from a lost notification
+    if (!transport_master_notified() && timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+        memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+        return true;
+    }
+#endif // defined(SPLIT_SLAVE_MATRIX_PUSH)
+
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
@@ -191,8 +553,17 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
 }
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+    bool changed = memcmp(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix)) != 0;
+#endif // defined(SPLIT_SLAVE_MATRIX_PUSH)
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+    if (changed) {
+        // A lost notification is picked up by the master's forced sync
+        transport_slave_notify();
+    }
+#endif // defined(SPLIT_SLAVE_MATRIX_PUSH)
 }
 
 // clang-format off
@@ -941,6 +1312,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_RPC)
@@ -952,6 +1324,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_BATCH_MASTER();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -120,6 +120,15 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    if defined(SPLIT_SLAVE_MATRIX_PUSH)
+bool transport_slave_notify(void) {
+    return soft_serial_target_notify();
+}
+bool transport_master_notified(void) {
+    return soft_serial_initiator_notified();
+}
+#    endif // defined(SPLIT_SLAVE_MATRIX_PUSH)
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
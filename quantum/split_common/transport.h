@@ -32,6 +32,10 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifndef SPLIT_TRANSPORT_BATCH_SIZE
+#    define SPLIT_TRANSPORT_BATCH_SIZE 16
+#endif // SPLIT_TRANSPORT_BATCH_SIZE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -41,6 +45,13 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#if defined(SPLIT_SLAVE_MATRIX_PUSH)
+// slave side, tells the master the matrix changed; call with the shared memory locked
+bool transport_slave_notify(void);
+// master side, returns whether the slave notified since the last call
+bool transport_master_notified(void);
+#endif // defined(SPLIT_SLAVE_MATRIX_PUSH)
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -133,6 +144,15 @@ typedef struct _split_slave_activity_sync_t {
 } split_slave_activity_sync_t;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#if defined(SPLIT_TRANSPORT_BATCH)
+typedef struct _split_batch_frame_t {
+    uint8_t checksum;
+    uint8_t flags;
+    uint8_t length;
+    uint8_t data[SPLIT_TRANSPORT_BATCH_SIZE];
+} split_batch_frame_t;
+#endif // defined(SPLIT_TRANSPORT_BATCH)
+
 #if defined(SPLIT_TRANSACTION_RPC)
 typedef struct _rpc_sync_info_t {
     uint8_t checksum;
@@ -223,6 +243,11 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#if defined(SPLIT_TRANSPORT_BATCH)
+    split_batch_frame_t batch_m2s;
+    split_batch_frame_t batch_s2m;
+#endif // defined(SPLIT_TRANSPORT_BATCH)
+
 #if defined(SPLIT_TRANSACTION_RPC)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
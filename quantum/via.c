@@ -65,6 +65,18 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(SCAN_PROFILER_ENABLE)
+#    include "scan_profiler.h"
+#endif
+
+#if defined(VIA_BULK_ENABLE)
+#    include "via_bulk.h"
+#endif
+
+#ifndef NO_ACTION_TAPPING
+#    include "action_tapping.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -297,6 +309,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+#ifdef VIA_BULK_ENABLE
+    // Bulk transfers send their own replies, and none at all for streamed data
+    if (via_bulk_command(data, length)) {
+        return;
+    }
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -469,6 +488,16 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         }
 #endif
         default: {
+#ifdef SCAN_PROFILER_ENABLE
+            if (scan_profiler_raw_hid_command(data, length)) {
+                break;
+            }
+#endif
+#ifndef NO_ACTION_TAPPING
+            if (waiting_buffer_raw_hid_command(data, length)) {
+                break;
+            }
+#endif
             // The command ID is not known
             // Return the unhandled state
             *command_id = id_unhandled;
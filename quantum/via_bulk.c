@@ -0,0 +1,365 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "via_bulk.h"
+#include "raw_hid.h"
+#include "dynamic_keymap.h"
+#include "matrix.h"
+
+#define VIA_BULK_KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#define VIA_BULK_KEYCODE_COUNT (VIA_BULK_KEYMAP_SIZE / 2)
+#define VIA_BULK_MAX_PACKET_SIZE 64
+
+#define VIA_BULK_RLE_MAX_LITERAL 128
+#define VIA_BULK_RLE_MAX_RUN 129
+
+typedef enum via_bulk_state_t {
+    VIA_BULK_IDLE,
+    VIA_BULK_READING,
+    VIA_BULK_WRITING,
+} via_bulk_state_t;
+
+typedef enum via_bulk_rle_state_t {
+    VIA_BULK_RLE_TOKEN,
+    VIA_BULK_RLE_LITERAL_HIGH,
+    VIA_BULK_RLE_LITERAL_LOW,
+    VIA_BULK_RLE_RUN_HIGH,
+    VIA_BULK_RLE_RUN_LOW,
+} via_bulk_rle_state_t;
+
+typedef struct via_bulk_rle_t {
+    via_bulk_rle_state_t state;
+    uint8_t              count;
+    uint16_t             keycode;
+} via_bulk_rle_t;
+
+static via_bulk_state_t via_bulk_state = VIA_BULK_IDLE;
+static uint8_t          via_bulk_flags;
+static uint8_t          via_bulk_sequence;
+static uint8_t          via_bulk_packet_size;
+static uint16_t         via_bulk_crc;
+static uint16_t         via_bulk_position; // keycodes read, or bytes staged
+static uint16_t         via_bulk_size;
+static uint8_t          via_bulk_status;
+static via_bulk_rle_t   via_bulk_rle;
+
+#ifdef VIA_BULK_WRITE_STAGING
+// Writes are decoded into here and only applied to the keymap once complete and verified
+static uint8_t via_bulk_staging[VIA_BULK_KEYMAP_SIZE];
+#else
+// Writes are decoded into here and written through to the keymap a packet's worth at a time
+static uint8_t via_bulk_chunk[VIA_BULK_MAX_PACKET_SIZE];
+static uint8_t via_bulk_chunk_length;
+#endif
+
+uint16_t via_bulk_crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+    while (length--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void via_bulk_reset(void) {
+    via_bulk_state    = VIA_BULK_IDLE;
+    via_bulk_sequence = 0;
+    via_bulk_crc      = 0xFFFF;
+    via_bulk_position = 0;
+    via_bulk_status   = VIA_BULK_STATUS_OK;
+    memset(&via_bulk_rle, 0, sizeof(via_bulk_rle));
+#ifndef VIA_BULK_WRITE_STAGING
+    via_bulk_chunk_length = 0;
+#endif
+}
+
+static void via_bulk_send(uint8_t *packet) {
+    raw_hid_send(packet, via_bulk_packet_size);
+}
+
+static void via_bulk_reply(uint8_t *data, uint8_t status) {
+    data[2] = status;
+    via_bulk_send(data);
+}
+
+static uint16_t via_bulk_keycode_at(uint16_t index) {
+    uint8_t buffer[2];
+    dynamic_keymap_get_buffer(index * 2, 2, buffer);
+    return (buffer[0] << 8) | buffer[1];
+}
+
+/* Reading */
+
+static void via_bulk_read_keycode(uint16_t keycode, uint8_t count) {
+    uint8_t buffer[2] = {keycode >> 8, keycode & 0xFF};
+    while (count--) {
+        via_bulk_crc = via_bulk_crc16(via_bulk_crc, buffer, 2);
+        via_bulk_position++;
+    }
+}
+
+static uint8_t via_bulk_read_next_byte(void) {
+    if (!(via_bulk_flags & VIA_BULK_FLAG_RLE)) {
+        uint8_t byte;
+        dynamic_keymap_get_buffer(via_bulk_position, 1, &byte);
+        via_bulk_crc = via_bulk_crc16(via_bulk_crc, &byte, 1);
+        via_bulk_position++;
+        return byte;
+    }
+
+    switch (via_bulk_rle.state) {
+        case VIA_BULK_RLE_TOKEN:
+        default: {
+            uint16_t keycode = via_bulk_keycode_at(via_bulk_position);
+            uint16_t run     = 1;
+            while (via_bulk_position + run < VIA_BULK_KEYCODE_COUNT && run < VIA_BULK_RLE_MAX_RUN && via_bulk_keycode_at(via_bulk_position + run) == keycode) {
+                run++;
+            }
+            if (run >= 2) {
+                via_bulk_rle.state   = VIA_BULK_RLE_RUN_HIGH;
+                via_bulk_rle.count   = run - 2;
+                via_bulk_rle.keycode = keycode;
+                return 0x80 | (run - 2);
+            }
+
+            // Literals continue up to the start of the next run
+            uint16_t literal = 1;
+            while (via_bulk_position + literal < VIA_BULK_KEYCODE_COUNT && literal < VIA_BULK_RLE_MAX_LITERAL) {
+                uint16_t index = via_bulk_position + literal;
+                if (index + 1 < VIA_BULK_KEYCODE_COUNT && via_bulk_keycode_at(index) == via_bulk_keycode_at(index + 1)) {
+                    break;
+                }
+                literal++;
+            }
+            via_bulk_rle.state = VIA_BULK_RLE_LITERAL_HIGH;
+            via_bulk_rle.count = literal - 1;
+            return literal - 1;
+        }
+        case VIA_BULK_RLE_LITERAL_HIGH:
+            via_bulk_rle.keycode = via_bulk_keycode_at(via_bulk_position);
+            via_bulk_rle.state   = VIA_BULK_RLE_LITERAL_LOW;
+            return via_bulk_rle.keycode >> 8;
+        case VIA_BULK_RLE_LITERAL_LOW:
+            via_bulk_read_keycode(via_bulk_rle.keycode, 1);
+            if (via_bulk_rle.count-- == 0) {
+                via_bulk_rle.state = VIA_BULK_RLE_TOKEN;
+            } else {
+                via_bulk_rle.state = VIA_BULK_RLE_LITERAL_HIGH;
+            }
+            return via_bulk_rle.keycode & 0xFF;
+        case VIA_BULK_RLE_RUN_HIGH:
+            via_bulk_rle.state = VIA_BULK_RLE_RUN_LOW;
+            return via_bulk_rle.keycode >> 8;
+        case VIA_BULK_RLE_RUN_LOW:
+            via_bulk_read_keycode(via_bulk_rle.keycode, via_bulk_rle.count + 2);
+            via_bulk_rle.state = VIA_BULK_RLE_TOKEN;
+            return via_bulk_rle.keycode & 0xFF;
+    }
+}
+
+static bool via_bulk_read_done(void) {
+    // Tokens are only started while keycodes remain, so a finished stream is back at a token boundary
+    uint16_t end = (via_bulk_flags & VIA_BULK_FLAG_RLE) ? VIA_BULK_KEYCODE_COUNT : VIA_BULK_KEYMAP_SIZE;
+    return via_bulk_position >= end && via_bulk_rle.state == VIA_BULK_RLE_TOKEN;
+}
+
+static void via_bulk_read_packet(void) {
+    uint8_t packet[VIA_BULK_MAX_PACKET_SIZE] = {0};
+    packet[0]                                = VIA_BULK_RAW_HID_ID;
+
+    if (via_bulk_read_done()) {
+        packet[1] = id_via_bulk_read_end;
+        packet[2] = VIA_BULK_STATUS_OK;
+        packet[3] = via_bulk_crc >> 8;
+        packet[4] = via_bulk_crc & 0xFF;
+        packet[5] = via_bulk_sequence;
+        via_bulk_send(packet);
+        via_bulk_reset();
+        return;
+    }
+
+    uint8_t length = 0;
+    while (length < via_bulk_packet_size - VIA_BULK_HEADER_SIZE && !via_bulk_read_done()) {
+        packet[VIA_BULK_HEADER_SIZE + length++] = via_bulk_read_next_byte();
+    }
+    packet[1] = id_via_bulk_read_data;
+    packet[2] = via_bulk_sequence++;
+    packet[3] = length;
+    via_bulk_send(packet);
+}
+
+void via_bulk_task(void) {
+    for (uint8_t i = 0; i < VIA_BULK_READ_PACKETS_PER_TASK && via_bulk_state == VIA_BULK_READING; i++) {
+        via_bulk_read_packet();
+    }
+}
+
+/* Writing */
+
+#ifndef VIA_BULK_WRITE_STAGING
+static void via_bulk_flush_chunk(void) {
+    dynamic_keymap_set_buffer(via_bulk_position - via_bulk_chunk_length, via_bulk_chunk_length, via_bulk_chunk);
+    via_bulk_chunk_length = 0;
+}
+#endif
+
+static void via_bulk_stage_byte(uint8_t byte) {
+    if (via_bulk_position >= via_bulk_size) {
+        via_bulk_status = VIA_BULK_STATUS_SIZE;
+        return;
+    }
+#ifdef VIA_BULK_WRITE_STAGING
+    via_bulk_staging[via_bulk_position++] = byte;
+#else
+    via_bulk_crc                            = via_bulk_crc16(via_bulk_crc, &byte, 1);
+    via_bulk_chunk[via_bulk_chunk_length++] = byte;
+    via_bulk_position++;
+    if (via_bulk_chunk_length == sizeof(via_bulk_chunk)) {
+        via_bulk_flush_chunk();
+    }
+#endif
+}
+
+static void via_bulk_stage_keycode(uint16_t keycode, uint8_t count) {
+    while (count-- && via_bulk_status == VIA_BULK_STATUS_OK) {
+        via_bulk_stage_byte(keycode >> 8);
+        via_bulk_stage_byte(keycode & 0xFF);
+    }
+}
+
+static void via_bulk_write_byte(uint8_t byte) {
+    if (!(via_bulk_flags & VIA_BULK_FLAG_RLE)) {
+        via_bulk_stage_byte(byte);
+        return;
+    }
+
+    switch (via_bulk_rle.state) {
+        case VIA_BULK_RLE_TOKEN:
+            via_bulk_rle.count = byte & 0x7F;
+            via_bulk_rle.state = (byte & 0x80) ? VIA_BULK_RLE_RUN_HIGH : VIA_BULK_RLE_LITERAL_HIGH;
+            break;
+        case VIA_BULK_RLE_LITERAL_HIGH:
+            via_bulk_rle.keycode = (uint16_t)byte << 8;
+            via_bulk_rle.state   = VIA_BULK_RLE_LITERAL_LOW;
+            break;
+        case VIA_BULK_RLE_RUN_HIGH:
+            via_bulk_rle.keycode = (uint16_t)byte << 8;
+            via_bulk_rle.state   = VIA_BULK_RLE_RUN_LOW;
+            break;
+        case VIA_BULK_RLE_LITERAL_LOW:
+            via_bulk_stage_keycode(via_bulk_rle.keycode | byte, 1);
+            if (via_bulk_rle.count-- == 0) {
+                via_bulk_rle.state = VIA_BULK_RLE_TOKEN;
+            } else {
+                via_bulk_rle.state = VIA_BULK_RLE_LITERAL_HIGH;
+            }
+            break;
+        case VIA_BULK_RLE_RUN_LOW:
+            via_bulk_stage_keycode(via_bulk_rle.keycode | byte, via_bulk_rle.count + 2);
+            via_bulk_rle.state = VIA_BULK_RLE_TOKEN;
+            break;
+    }
+}
+
+static void via_bulk_write_data(uint8_t *data, uint8_t length) {
+    if (via_bulk_status != VIA_BULK_STATUS_OK) {
+        return;
+    }
+    if (data[2] != via_bulk_sequence++) {
+        via_bulk_status = VIA_BULK_STATUS_SEQUENCE;
+        return;
+    }
+    if (data[3] > length - VIA_BULK_HEADER_SIZE) {
+        via_bulk_status = VIA_BULK_STATUS_INVALID;
+        return;
+    }
+    for (uint8_t i = 0; i < data[3] && via_bulk_status == VIA_BULK_STATUS_OK; i++) {
+        via_bulk_write_byte(data[VIA_BULK_HEADER_SIZE + i]);
+    }
+}
+
+static uint8_t via_bulk_write_commit(uint16_t crc) {
+    if (via_bulk_status != VIA_BULK_STATUS_OK) {
+        return via_bulk_status;
+    }
+    if (via_bulk_position != via_bulk_size) {
+        return VIA_BULK_STATUS_SIZE;
+    }
+    if (via_bulk_rle.state != VIA_BULK_RLE_TOKEN) {
+        return VIA_BULK_STATUS_ENCODING;
+    }
+#ifdef VIA_BULK_WRITE_STAGING
+    if (via_bulk_crc16(0xFFFF, via_bulk_staging, via_bulk_size) != crc) {
+        return VIA_BULK_STATUS_CRC;
+    }
+    dynamic_keymap_set_buffer(0, via_bulk_size, via_bulk_staging);
+#else
+    // Everything else has already been written, so a mismatch can only be reported
+    via_bulk_flush_chunk();
+    if (via_bulk_crc != crc) {
+        return VIA_BULK_STATUS_CRC;
+    }
+#endif
+    return VIA_BULK_STATUS_OK;
+}
+
+bool via_bulk_command(uint8_t *data, uint8_t length) {
+    // data = [ command_id, bulk_command_id, ... ]
+    if (length < VIA_BULK_HEADER_SIZE + 2 || length > VIA_BULK_MAX_PACKET_SIZE || data[0] != VIA_BULK_RAW_HID_ID) {
+        return false;
+    }
+
+    switch (data[1]) {
+        case id_via_bulk_read_begin:
+            via_bulk_reset();
+            via_bulk_packet_size = length;
+            via_bulk_flags       = data[2];
+            via_bulk_state       = VIA_BULK_READING;
+            data[3]              = VIA_BULK_KEYMAP_SIZE >> 8;
+            data[4]              = VIA_BULK_KEYMAP_SIZE & 0xFF;
+            via_bulk_reply(data, VIA_BULK_STATUS_OK);
+            break;
+        case id_via_bulk_write_begin: {
+            uint16_t size = (data[3] << 8) | data[4];
+            via_bulk_reset();
+            via_bulk_packet_size = length;
+            if (size == 0 || size > VIA_BULK_KEYMAP_SIZE || (size & 1)) {
+                via_bulk_reply(data, VIA_BULK_STATUS_SIZE);
+                break;
+            }
+            via_bulk_flags = data[2];
+            via_bulk_size  = size;
+            via_bulk_state = VIA_BULK_WRITING;
+            via_bulk_reply(data, VIA_BULK_STATUS_OK);
+            break;
+        }
+        case id_via_bulk_write_data:
+            // Not acknowledged, so that the host can send the whole stream without waiting
+            if (via_bulk_state == VIA_BULK_WRITING) {
+                via_bulk_write_data(data, length);
+            }
+            break;
+        case id_via_bulk_write_commit: {
+            uint8_t status = VIA_BULK_STATUS_INVALID;
+            if (via_bulk_state == VIA_BULK_WRITING) {
+                status = via_bulk_write_commit((data[2] << 8) | data[3]);
+            }
+            via_bulk_reset();
+            via_bulk_packet_size = length;
+            via_bulk_reply(data, status);
+            break;
+        }
+        case id_via_bulk_abort:
+            via_bulk_reset();
+            via_bulk_packet_size = length;
+            via_bulk_reply(data, VIA_BULK_STATUS_OK);
+            break;
+        default:
+            via_bulk_packet_size = length;
+            via_bulk_reply(data, VIA_BULK_STATUS_INVALID);
+            break;
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Bulk dynamic keymap transfer over raw HID.
+
+    Reading or writing the whole dynamic keymap with VIA's get/set buffer commands takes a
+    round trip per 28 bytes. Bulk transfers instead stream the keymap in consecutive packets
+    without acknowledging each of them, optionally run-length encoded, and check each transfer
+    against a CRC of the whole keymap. Writes are passed to the keymap as they arrive, unless
+    VIA_BULK_WRITE_STAGING is defined, which holds them in a keymap-sized RAM buffer until the
+    CRC has been checked. Enable with
+    `VIA_BULK_ENABLE = yes` in rules.mk. With VIA enabled, packets are dispatched from
+    raw_hid_receive() automatically; otherwise call via_bulk_command() from your own.
+
+    Every packet is [ VIA_BULK_RAW_HID_ID, command, ... ]:
+
+        read begin   host:   [ id, 0x01, flags ]
+                     device: [ id, 0x01, status, size (BE16) ]
+                     then a stream of read data packets, followed by read end
+        read data    device: [ id, 0x81, sequence, length, payload... ]
+        read end     device: [ id, 0x82, status, crc (BE16), packet count ]
+        write begin  host:   [ id, 0x02, flags, size (BE16) ]
+                     device: [ id, 0x02, status ]
+        write data   host:   [ id, 0x03, sequence, length, payload... ], not acknowledged
+        write commit host:   [ id, 0x04, crc (BE16) ]
+                     device: [ id, 0x04, status ]
+        abort        host:   [ id, 0x05 ]
+                     device: [ id, 0x05, status ]
+
+    Sizes and CRCs refer to the uncompressed keymap, laid out as dynamic_keymap_get_buffer()
+    does, with CRC-16/CCITT-FALSE. Sequence numbers start at 0 for each transfer.
+
+    With VIA_BULK_FLAG_RLE the payload is a series of tokens over big-endian keycodes:
+    0x00-0x7F is followed by (token + 1) literal keycodes, 0x80-0xFF by a single keycode
+    repeated (token - 0x80 + 2) times.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef VIA_BULK_RAW_HID_ID
+#    define VIA_BULK_RAW_HID_ID 0xB1
+#endif
+
+// Read data packets sent on each call to via_bulk_task()
+#ifndef VIA_BULK_READ_PACKETS_PER_TASK
+#    define VIA_BULK_READ_PACKETS_PER_TASK 1
+#endif
+
+#define VIA_BULK_HEADER_SIZE 4
+
+enum via_bulk_command_id {
+    id_via_bulk_read_begin   = 0x01,
+    id_via_bulk_write_begin  = 0x02,
+    id_via_bulk_write_data   = 0x03,
+    id_via_bulk_write_commit = 0x04,
+    id_via_bulk_abort        = 0x05,
+    id_via_bulk_read_data    = 0x81,
+    id_via_bulk_read_end     = 0x82,
+};
+
+enum via_bulk_flags {
+    VIA_BULK_FLAG_RLE = 0x01,
+};
+
+enum via_bulk_status {
+    VIA_BULK_STATUS_OK       = 0x00,
+    VIA_BULK_STATUS_INVALID  = 0x01,
+    VIA_BULK_STATUS_SIZE     = 0x02,
+    VIA_BULK_STATUS_SEQUENCE = 0x03,
+    VIA_BULK_STATUS_ENCODING = 0x04,
+    VIA_BULK_STATUS_CRC      = 0x05,
+};
+
+/**
+ * @brief Handles a bulk transfer raw HID packet, sending any response itself.
+ *
+ * @return true if the packet was a bulk transfer command
+ */
+bool via_bulk_command(uint8_t *data, uint8_t length);
+
+/**
+ * @brief Streams pending read data packets.
+ */
+void via_bulk_task(void);
+
+/**
+ * @brief Calculates the CRC-16/CCITT-FALSE used to verify transfers.
+ */
+uint16_t via_bulk_crc16(uint16_t crc, const uint8_t *data, uint16_t length);
@@ -24,6 +24,12 @@ void MockBackingStore::reset_instance() {
     backing_write_invoke_count  = 0;
     backing_lock_invoke_count   = 0;
 
+    backing_read_invoke_count      = 0;
+    backing_read_bulk_invoke_count = 0;
+
+    backing_erase_step_invoke_count = 0;
+    backing_elapsed_time            = 0;
+
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
     unlock_success_callback = [](std::uint64_t) { return true; };
@@ -72,6 +78,31 @@ bool MockBackingStore::erase(void) {
     append_log(true);
 
     ++backing_erasure_count;
+    backing_elapsed_time += MOCK_SECTOR_ERASE_TIME::value * (BACKING_STORE_ELEMENT_COUNT::value / MOCK_SECTOR_ELEMENT_COUNT::value);
+    return true;
+}
+
+bool MockBackingStore::erase_step(std::uint32_t address, std::uint32_t end, std::uint32_t& next) {
+    ++backing_erase_step_invoke_count;
+
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+    EXPECT_EQ(address % MOCK_BACKING_STORE_SECTOR_SIZE, 0) << "Erase step should start on a sector boundary";
+    EXPECT_LE(address + MOCK_BACKING_STORE_SECTOR_SIZE, end) << "Erase step should not go past the end of the requested range";
+    EXPECT_LE(end, WEAR_LEVELING_BACKING_SIZE) << "Erase step would result of out-of-bounds access";
+
+    // Erase the single sector at the requested address
+    std::size_t begin = address / sizeof(backing_store_int_t);
+    for (std::size_t i = begin; i < begin + MOCK_SECTOR_ELEMENT_COUNT::value; ++i) {
+        backing_storage[i].erase();
+    }
+    backing_elapsed_time += MOCK_SECTOR_ERASE_TIME::value;
+
+    next = address + MOCK_BACKING_STORE_SECTOR_SIZE;
+    if (next >= end) {
+        // Only track completed erases of a range, so that they're counted the same way as a full erase
+        append_log(true);
+        ++backing_erasure_count;
+    }
     return true;
 }
 
@@ -97,6 +128,7 @@ bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
 
     // Keep track of the total number of writes into the backing store
     ++backing_total_write_count;
+    backing_elapsed_time += MOCK_WRITE_TIME::value;
 
     return true;
 }
@@ -114,6 +146,9 @@ bool MockBackingStore::lock(void) {
 }
 
 bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const {
+    ++backing_read_invoke_count;
+    backing_elapsed_time += MOCK_READ_TIME::value;
+
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
@@ -125,6 +160,22 @@ bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const
     return true;
 }
 
+bool MockBackingStore::read_bulk(uint32_t address, backing_store_int_t* values, std::size_t item_count) const {
+    ++backing_read_bulk_invoke_count;
+    backing_elapsed_time += MOCK_READ_TIME::value * item_count;
+
+    EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
+    EXPECT_TRUE(address + item_count * BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+
+    // Read and take the complement as we're simulating flash memory -- 0xFF means 0x00
+    std::size_t index = address / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = 0; i < item_count; ++i) {
+        values[i] = ~backing_storage[index + i].get();
+    }
+
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Backing Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +192,10 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+extern "C" bool backing_store_erase_step(uint32_t address, uint32_t end, uint32_t* next) {
+    return MockBackingStore::Instance().erase_step(address, end, *next);
+}
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -152,3 +207,7 @@ extern "C" bool backing_store_lock(void) {
 extern "C" bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     return MockBackingStore::Instance().read(address, *value);
 }
+
+extern "C" bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().read_bulk(address, values, item_count);
+}
@@ -22,6 +22,17 @@ using BACKING_STORE_INTEGRAL_COMPLEMENT = std::integral_constant<backing_store_i
 // Total number of elements stored in the backing arrays
 using BACKING_STORE_ELEMENT_COUNT = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / sizeof(backing_store_int_t))>;
 
+#ifndef MOCK_BACKING_STORE_SECTOR_SIZE
+#    define MOCK_BACKING_STORE_SECTOR_SIZE WEAR_LEVELING_BACKING_SIZE
+#endif
+// Number of elements erased by each stepped erase
+using MOCK_SECTOR_ELEMENT_COUNT = std::integral_constant<std::size_t, (MOCK_BACKING_STORE_SECTOR_SIZE / sizeof(backing_store_int_t))>;
+
+// Simulated duration of backing store operations, in microseconds, loosely based on embedded flash
+using MOCK_SECTOR_ERASE_TIME = std::integral_constant<std::uint64_t, 20000>;
+using MOCK_WRITE_TIME        = std::integral_constant<std::uint64_t, 50>;
+using MOCK_READ_TIME         = std::integral_constant<std::uint64_t, 1>;
+
 class MockBackingStoreElement {
    private:
     backing_store_int_t value;
@@ -96,6 +107,13 @@ class MockBackingStore {
     std::uint64_t backing_erase_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    // Reads don't modify the backing store, but are still counted
+    mutable std::uint64_t backing_read_invoke_count;
+    mutable std::uint64_t backing_read_bulk_invoke_count;
+    std::uint64_t         backing_erase_step_invoke_count;
+
+    // Simulated time spent in backing store operations, in microseconds
+    mutable std::uint64_t backing_elapsed_time;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -147,6 +165,23 @@ class MockBackingStore {
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
+    std::uint64_t read_bulk_invoke_count() const {
+        return backing_read_bulk_invoke_count;
+    }
+    std::uint64_t erase_step_invoke_count() const {
+        return backing_erase_step_invoke_count;
+    }
+
+    // Simulated time spent in backing store operations since the last reset, in microseconds
+    std::uint64_t elapsed_time() const {
+        return backing_elapsed_time;
+    }
+    void reset_elapsed_time() {
+        backing_elapsed_time = 0;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -159,9 +194,11 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_step(std::uint32_t address, std::uint32_t end, std::uint32_t& next);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
+    bool read_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count) const;
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
@@ -0,0 +1,279 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Longest any single call is allowed to take: one sector erase, or one step's worth of writes plus the checksum
+using CALL_TIME_BUDGET = std::integral_constant<std::uint64_t, std::max(MOCK_SECTOR_ERASE_TIME::value, (WEAR_LEVELING_BACKGROUND_WRITE_SIZE / BACKING_STORE_WRITE_SIZE + 8) * MOCK_WRITE_TIME::value)>;
+
+class WearLevelingBackground : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+        wear_leveling_init();
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    /**
+     * Writes a 4-byte value somewhere in the logical area, returning the simulated time it took.
+     */
+    static std::uint64_t timed_write(std::size_t index, wear_leveling_status_t* status = nullptr) {
+        return timed_write_at((uint32_t)((index * 36) % (WEAR_LEVELING_LOGICAL_SIZE - 4)), index, status);
+    }
+
+    /**
+     * Writes a 4-byte value at the supplied address, returning the simulated time it took.
+     */
+    static std::uint64_t timed_write_at(uint32_t address, std::size_t index, wear_leveling_status_t* status = nullptr) {
+        auto&        inst    = MockBackingStore::Instance();
+        std::uint8_t data[4] = {(std::uint8_t)(index + 1), (std::uint8_t)(index >> 8), 0x5A, (std::uint8_t)(index * 7)};
+        memcpy(&verify_data[address], data, sizeof(data));
+
+        inst.reset_elapsed_time();
+        wear_leveling_status_t result = wear_leveling_write(address, data, sizeof(data));
+        EXPECT_NE(result, WEAR_LEVELING_FAILED) << "Write failed with incorrect status";
+        if (status) {
+            *status = result;
+        }
+        return inst.elapsed_time();
+    }
+
+    /**
+     * Performs one background step, returning the simulated time it took.
+     */
+    static std::uint64_t timed_step(wear_leveling_status_t* status) {
+        auto& inst = MockBackingStore::Instance();
+        inst.reset_elapsed_time();
+        *status = wear_leveling_consolidate_step();
+        EXPECT_NE(*status, WEAR_LEVELING_FAILED) << "Step failed with incorrect status";
+        return inst.elapsed_time();
+    }
+
+    /**
+     * Performs background steps until the bank being consolidated into has been erased.
+     */
+    static void finish_erasing() {
+        auto&                  inst     = MockBackingStore::Instance();
+        const std::uint64_t    erasures = inst.erasure_count();
+        wear_leveling_status_t status;
+        while (inst.erasure_count() == erasures) {
+            timed_step(&status);
+        }
+    }
+
+    /**
+     * Performs background steps until the consolidation in progress completes.
+     */
+    static void finish_consolidation() {
+        wear_leveling_status_t status;
+        do {
+            timed_step(&status);
+        } while (status != WEAR_LEVELING_CONSOLIDATED);
+    }
+
+    /**
+     * Writes until background consolidation starts, then performs a couple more erase steps.
+     *
+     * @return the index of the next write
+     */
+    static std::size_t start_consolidation(std::size_t index) {
+        auto&                  inst   = MockBackingStore::Instance();
+        const std::uint64_t    steps  = inst.erase_step_invoke_count();
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        while (inst.erase_step_invoke_count() == steps) {
+            timed_write(index++);
+            timed_step(&status);
+        }
+        timed_step(&status);
+        timed_step(&status);
+        EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+        return index;
+    }
+
+    static void verify_after_init() {
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed with incorrect status";
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Read failed with incorrect status";
+        EXPECT_THAT(actual, testing::ElementsAreArray(verify_data));
+    }
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingBackground::verify_data;
+
+/**
+ * Background steps do nothing until the write log passes the high water mark.
+ */
+TEST_F(WearLevelingBackground, StepIsNoOpBelowHighWaterMark) {
+    auto& inst = MockBackingStore::Instance();
+    for (std::size_t i = 0; i < 10; ++i) {
+        timed_write(i);
+    }
+
+    wear_leveling_status_t status;
+    EXPECT_EQ(timed_step(&status), 0);
+    EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erase_step_invoke_count(), 0);
+    EXPECT_EQ(inst.erasure_count(), 0);
+}
+
+/**
+ * Simulates a long session of writes separated by idle time, checking that no call ever exceeds the budget.
+ */
+TEST_F(WearLevelingBackground, NoCallExceedsBudget) {
+    auto&         inst            = MockBackingStore::Instance();
+    std::uint64_t max_write_time  = 0;
+    std::uint64_t max_step_time   = 0;
+    std::size_t   consolidations  = 0;
+    std::size_t   steps_performed = 0;
+
+    for (std::size_t i = 0; i < 4000; ++i) {
+        wear_leveling_status_t status;
+        max_write_time = std::max(max_write_time, timed_write(i, &status));
+        EXPECT_EQ(status, WEAR_LEVELING_SUCCESS) << "Write should never have needed to consolidate";
+
+        // Idle time after every burst of writes, during which housekeeping runs until there's nothing left to do
+        if (i % 16 == 15) {
+            std::uint64_t elapsed;
+            do {
+                elapsed       = timed_step(&status);
+                max_step_time = std::max(max_step_time, elapsed);
+                if (elapsed > 0) {
+                    ++steps_performed;
+                }
+                if (status == WEAR_LEVELING_CONSOLIDATED) {
+                    ++consolidations;
+                }
+            } while (elapsed > 0);
+        }
+    }
+
+    EXPECT_GE(consolidations, 2);
+    EXPECT_EQ(inst.erasure_count(), consolidations);
+    EXPECT_LE(max_write_time, CALL_TIME_BUDGET::value);
+    EXPECT_LE(max_step_time, CALL_TIME_BUDGET::value);
+
+    verify_after_init();
+}
+
+/**
+ * Without background steps, the write which fills the log stalls for the whole erase and rewrite.
+ */
+TEST_F(WearLevelingBackground, SynchronousConsolidationExceedsBudget) {
+    auto&         inst           = MockBackingStore::Instance();
+    std::uint64_t max_write_time = 0;
+
+    for (std::size_t i = 0; inst.erasure_count() == 0; ++i) {
+        max_write_time = std::max(max_write_time, timed_write(i));
+    }
+
+    EXPECT_GT(max_write_time, CALL_TIME_BUDGET::value);
+
+    verify_after_init();
+}
+
+/**
+ * A write arriving midway through a background consolidation doesn't wait for it, and is kept once it completes.
+ */
+TEST_F(WearLevelingBackground, WriteDuringConsolidationDoesNotWaitForIt) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::size_t i = start_consolidation(0);
+    EXPECT_EQ(inst.erasure_count(), 0) << "Consolidation should still be in progress";
+
+    wear_leveling_status_t status;
+    EXPECT_LE(timed_write(i++, &status), CALL_TIME_BUDGET::value);
+    EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erasure_count(), 0) << "Consolidation should not have been completed by the write";
+
+    // Once some of the cache has been written to the new bank, update data on both sides of what's been written
+    finish_erasing();
+    timed_step(&status);
+    timed_step(&status);
+    EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+    EXPECT_LE(timed_write_at(0, i++, &status), CALL_TIME_BUDGET::value);
+    EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+    EXPECT_LE(timed_write_at(WEAR_LEVELING_LOGICAL_SIZE - 4, i++, &status), CALL_TIME_BUDGET::value);
+    EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+
+    finish_consolidation();
+    EXPECT_EQ(inst.erasure_count(), 1);
+    EXPECT_FALSE(wear_leveling_consolidate_pending());
+
+    verify_after_init();
+}
+
+/**
+ * Finishing a consolidation completes it in one call, leaving nothing for the background.
+ */
+TEST_F(WearLevelingBackground, FinishCompletesConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+
+    EXPECT_FALSE(wear_leveling_consolidate_pending());
+    EXPECT_EQ(wear_leveling_consolidate_finish(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.erase_step_invoke_count(), 0);
+
+    start_consolidation(0);
+    EXPECT_TRUE(wear_leveling_consolidate_pending());
+    EXPECT_EQ(wear_leveling_consolidate_finish(), WEAR_LEVELING_CONSOLIDATED);
+    EXPECT_EQ(inst.erasure_count(), 1);
+    EXPECT_FALSE(wear_leveling_consolidate_pending());
+
+    wear_leveling_status_t status;
+    EXPECT_EQ(timed_step(&status), 0);
+    EXPECT_EQ(status, WEAR_LEVELING_SUCCESS);
+
+    verify_after_init();
+}
+
+/**
+ * Power loss at any point of a background consolidation, with writes arriving throughout, keeps the latest data.
+ */
+TEST_F(WearLevelingBackground, InitAfterInterruptedConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+
+    using storage_snapshot = std::vector<MockBackingStoreElement>;
+    std::vector<std::pair<storage_snapshot, std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>>> snapshots;
+    auto snapshot = [&]() { snapshots.emplace_back(storage_snapshot(inst.storage_begin(), inst.storage_end()), verify_data); };
+
+    // Get a first consolidation out of the way, so that the second one goes back into the first bank
+    std::size_t i = start_consolidation(0);
+    finish_consolidation();
+    i = start_consolidation(i);
+
+    // Power may be lost before any write to the backing store, including partway through the sequence and checksum
+    bool in_step = false;
+    inst.set_write_callback([&](std::uint64_t, std::uint32_t address) {
+        if (in_step && address % (WEAR_LEVELING_BANK_SIZE) >= WEAR_LEVELING_LOGICAL_SIZE) {
+            snapshot();
+        }
+        return true;
+    });
+
+    wear_leveling_status_t status;
+    do {
+        in_step = true;
+        timed_step(&status);
+        in_step = false;
+        snapshot();
+        timed_write(i++);
+        snapshot();
+    } while (status != WEAR_LEVELING_CONSOLIDATED);
+    EXPECT_EQ(inst.erasure_count(), 2);
+    inst.set_write_callback(nullptr);
+
+    for (std::size_t n = 0; n < snapshots.size(); ++n) {
+        std::copy(snapshots[n].first.begin(), snapshots[n].first.end(), inst.storage_begin());
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed with incorrect status";
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Read failed with incorrect status";
+        EXPECT_EQ(actual, snapshots[n].second) << "Latest data should survive power loss at snapshot " << n;
+    }
+
+    // The backing store is still usable after the last power loss
+    verify_data = snapshots.back().second;
+    timed_write(i++);
+    verify_after_init();
+}
@@ -0,0 +1,136 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingPlayback : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        std::fill(verify_data.begin(), verify_data.end(), 0);
+        wear_leveling_init();
+    }
+
+    static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    /**
+     * Writes a mix of entry types and lengths, so that entries straddle the playback read boundaries.
+     */
+    static wear_leveling_status_t write_entry(std::size_t index) {
+        std::uint8_t data[5];
+        std::size_t  length  = 1 + index % 5;
+        std::uint8_t seed    = (std::uint8_t)(index * 37 + 1);
+        uint32_t     address = (uint32_t)((index * 13) % (WEAR_LEVELING_LOGICAL_SIZE - length));
+        for (std::size_t i = 0; i < length; ++i) {
+            data[i] = seed + (std::uint8_t)i;
+        }
+        if (index % 7 == 0) {
+            // Word-encoded 0/1 entries
+            address &= ~1u;
+            data[0] = index % 2;
+            data[1] = 0;
+            length  = 2;
+        }
+        return test_write(address, data, length);
+    }
+
+    /**
+     * Returns the number of bytes used by the write log, as seen in the backing store.
+     */
+    static std::size_t log_size() {
+        auto&       inst = MockBackingStore::Instance();
+        std::size_t last = 0;
+        for (auto it = inst.storage_begin(); it != inst.storage_end(); ++it) {
+            if (!it->is_erased()) {
+                last = std::distance(inst.storage_begin(), it) + 1;
+            }
+        }
+        std::size_t log_start = WEAR_LEVELING_LOGICAL_SIZE + 8;
+        return last * BACKING_STORE_WRITE_SIZE > log_start ? last * BACKING_STORE_WRITE_SIZE - log_start : 0;
+    }
+
+    static void verify_cache() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Read failed with incorrect status";
+        EXPECT_THAT(actual, testing::ElementsAreArray(verify_data));
+    }
+};
+
+std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> WearLevelingPlayback::verify_data;
+
+/**
+ * Counts the backing store reads needed to play back a nearly-full write log at init.
+ */
+TEST_F(WearLevelingPlayback, NearlyFullLogUsesBulkReads) {
+    auto&             inst      = MockBackingStore::Instance();
+    const std::size_t log_space = WEAR_LEVELING_LOG_END - (WEAR_LEVELING_LOGICAL_SIZE + 8);
+
+    // Fill the log until there's no longer room for the largest entry
+    std::size_t entries = 0;
+    while (inst.total_write_count() * BACKING_STORE_WRITE_SIZE + 8 < log_space) {
+        EXPECT_EQ(write_entry(entries++), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    EXPECT_EQ(inst.erasure_count(), 0) << "Log was consolidated while filling";
+
+    const std::size_t log_bytes  = log_size();
+    const std::size_t reads      = inst.read_invoke_count();
+    const std::size_t bulk_reads = inst.read_bulk_invoke_count();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed with incorrect status";
+    const std::size_t init_reads      = inst.read_invoke_count() - reads;
+    const std::size_t init_bulk_reads = inst.read_bulk_invoke_count() - bulk_reads;
+
+    // Consolidated data + checksum, then one bulk read per window of the log
+    const std::size_t expected_max = 2 + (log_bytes + WEAR_LEVELING_PLAYBACK_READ_SIZE - 1) / WEAR_LEVELING_PLAYBACK_READ_SIZE + 1;
+    EXPECT_EQ(init_reads, 0) << "Playback should only use bulk reads";
+    EXPECT_LE(init_bulk_reads, expected_max);
+    EXPECT_EQ(inst.erasure_count(), 0) << "Init should not have consolidated";
+
+    verify_cache();
+}
+
+/**
+ * Playback must resume appending at the end of the log, not at the end of the last bulk read.
+ */
+TEST_F(WearLevelingPlayback, AppendsAfterPlayback) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (std::size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(write_entry(i), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    const std::size_t before = log_size();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed with incorrect status";
+    EXPECT_EQ(write_entry(10), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_GT(log_size(), before);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed with incorrect status";
+    EXPECT_EQ(inst.erasure_count(), 0);
+    verify_cache();
+}
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+/**
+ * With a checkpoint interval the log never grows beyond it, so playback stays bounded however much is written.
+ */
+TEST_F(WearLevelingPlayback, CheckpointIntervalBoundsLog) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (std::size_t i = 0; i < 4 * WEAR_LEVELING_CHECKPOINT_INTERVAL / 8; ++i) {
+        EXPECT_NE(write_entry(i), WEAR_LEVELING_FAILED) << "Write failed with incorrect status";
+        EXPECT_LT(log_size(), WEAR_LEVELING_CHECKPOINT_INTERVAL);
+    }
+    EXPECT_GE(inst.erasure_count(), 3) << "Log should have been consolidated at each checkpoint";
+
+    const std::size_t bulk_reads = inst.read_bulk_invoke_count();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init failed with incorrect status";
+    EXPECT_LE(inst.read_bulk_invoke_count() - bulk_reads, 2 + WEAR_LEVELING_CHECKPOINT_INTERVAL / WEAR_LEVELING_PLAYBACK_READ_SIZE + 1);
+
+    verify_cache();
+}
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
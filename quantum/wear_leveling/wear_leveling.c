@@ -62,12 +62,31 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_PLAYBACK_READ_SIZE: The number of bytes of write log
+            fetched from the backing store at a time during playback. Larger
+            values mean fewer backing store transactions at init, at the cost
+            of stack usage.
+
+        - WEAR_LEVELING_CHECKPOINT_INTERVAL: Optional. The number of bytes the
+            write log may hold before the cache is consolidated, even if the
+            backing store has space left. Bounds the playback cost at init, at
+            the cost of more frequent erases.
+
+        - WEAR_LEVELING_BACKGROUND_CONSOLIDATION: Optional. Allows consolidation
+            to be performed in small steps through wear_leveling_consolidate_step()
+            once the write log passes WEAR_LEVELING_BACKGROUND_HIGH_WATER_MARK
+            bytes, each step erasing one sector or writing
+            WEAR_LEVELING_BACKGROUND_WRITE_SIZE bytes of consolidated data.
+            The backing store is split into two banks, each with its own
+            consolidated data and write log, so this requires a backing size of
+            at least four times the logical size.
+
     General algorithm:
 
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly, reading the log in bulk.
 
         During reads:
             * Logical data is served from the cache.
@@ -75,13 +94,28 @@
         During writes:
             * The cache is updated with the new data.
             * A new write log entry is appended to the log.
-            * If the log's full, data is consolidated and the write log cleared.
+            * If the log's full (or has reached the checkpoint interval), data is
+                consolidated and the write log cleared.
+            * If a background consolidation has already written the affected
+                consolidated data, the entry is also appended to the new bank's
+                write log.
+
+    Background consolidation:
+
+        The bank not in use is erased a sector at a time, then the cache is
+        written to its consolidated data section in chunks. Once all of it has
+        been written, the bank's sequence number and checksum are written, at
+        which point it becomes the bank in use. Until then the previous bank
+        holds the latest data, so a power loss at any point leaves at least one
+        bank with valid consolidated data and a complete write log. At init,
+        the valid bank with the newest sequence number is used.
 
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
         of the consolidated data area, in an attempt to detect and guard against
-        any data corruption.
+        any data corruption. With background consolidation, these are followed
+        by the bank's 8-byte sequence number, which is included in the hash.
 
         The write log follows the hash:
 
@@ -163,8 +197,33 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    uint32_t bank_base;
+    uint64_t sequence;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Background consolidation state. While erasing, `address` is the next backing store address to erase; while writing,
+ * the next cache offset.
+ */
+typedef enum wear_leveling_background_state_t { BACKGROUND_IDLE = 0, BACKGROUND_ERASING, BACKGROUND_WRITING } wear_leveling_background_state_t;
+
+static struct {
+    wear_leveling_background_state_t state;
+    uint32_t                         bank_base;
+    uint32_t                         address;
+    uint32_t                         write_address;
+    uint64_t                         hash;
+} wear_leveling_background;
+
+// Translates an address within a bank to one within the backing store
+#    define BANK_ADDRESS(address) (wear_leveling.bank_base + (address))
+#else
+#    define BANK_ADDRESS(address) (address)
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -203,9 +262,88 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_START);
 }
 
+/**
+ * Reads an 8-byte value, such as the checksum, from the backing store.
+ */
+static bool wear_leveling_read_entry(uint32_t address, uint64_t *value) {
+    write_log_entry_t entry;
+#if BACKING_STORE_WRITE_SIZE == 2
+    bool ok = backing_store_read_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    bool ok = backing_store_read_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    bool ok = backing_store_read(address, &entry.raw64);
+#endif
+    *value = entry.raw64;
+    return ok;
+}
+
+/**
+ * Writes an 8-byte value, such as the checksum, to the backing store.
+ * Pre-condition: the backing store is unlocked.
+ */
+static bool wear_leveling_write_entry(uint32_t address, uint64_t value) {
+    write_log_entry_t entry;
+    entry.raw64 = value;
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry.raw64);
+#endif
+}
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Extends the FNV1a_64 of a bank's consolidated data with its sequence number, giving the checksum stored in the bank.
+ */
+static uint64_t wear_leveling_checksum(uint64_t hash, uint64_t sequence) {
+    return fnv_64a_buf(&sequence, sizeof(sequence), hash);
+}
+
+/**
+ * Checks the consolidated data of the bank at the supplied base address against its checksum, without using the cache.
+ */
+static bool wear_leveling_bank_valid(uint32_t base, uint64_t *sequence) {
+    backing_store_int_t values[(WEAR_LEVELING_PLAYBACK_READ_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint64_t            hash = FNV1A_64_INIT;
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_LOGICAL_SIZE); offset += sizeof(values)) {
+        uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+        if (length > sizeof(values)) {
+            length = sizeof(values);
+        }
+        if (!backing_store_read_bulk(base + offset, values, length / (BACKING_STORE_WRITE_SIZE))) {
+            return false;
+        }
+        hash = fnv_64a_buf(values, length, hash);
+    }
+
+    uint64_t checksum;
+    if (!wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &checksum) || !wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, sequence)) {
+        return false;
+    }
+    return checksum == wear_leveling_checksum(hash, *sequence);
+}
+
+/**
+ * Selects the bank holding the latest consolidated data -- the valid one with the newest sequence number.
+ */
+static void wear_leveling_select_bank(void) {
+    uint64_t sequence0 = 0;
+    uint64_t sequence1 = 0;
+    bool     valid0    = wear_leveling_bank_valid(0, &sequence0);
+    bool     valid1    = wear_leveling_bank_valid((WEAR_LEVELING_BANK_SIZE), &sequence1);
+
+    wear_leveling.bank_base = (valid1 && (!valid0 || (int64_t)(sequence1 - sequence0) > 0)) ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    wear_leveling.sequence  = 0;
+    wl_dprintf("Using bank at %d\n", (int)wear_leveling.bank_base);
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -214,27 +352,29 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     wl_dprintf("Reading consolidated data\n");
 
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_read_bulk(BANK_ADDRESS(0), (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
     // Verify the FNV1a_64 result
     if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        write_log_entry_t entry;
+        uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        uint64_t checksum = 0;
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+        uint64_t sequence = 0;
+        wear_leveling_read_entry(BANK_ADDRESS(WEAR_LEVELING_LOGICAL_SIZE) + 8, &sequence);
+        expected = wear_leveling_checksum(expected, sequence);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_entry(BANK_ADDRESS(WEAR_LEVELING_LOGICAL_SIZE), &checksum);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
+        if (checksum == expected) {
             wl_dprintf("Checksum matches, consolidated data is correct\n");
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+            wear_leveling.sequence = sequence;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
         } else {
             wl_dprintf("Checksum mismatch, clearing cache\n");
             wear_leveling_clear_cache();
@@ -249,6 +389,16 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+#ifndef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Writes the FNV1a_64 result of the cache after the consolidated data.
+ * Pre-condition: the backing store is unlocked.
+ */
+static bool wear_leveling_write_checksum(void) {
+    wl_dprintf("Writing checksum\n");
+    return wear_leveling_write_entry((WEAR_LEVELING_LOGICAL_SIZE), fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT));
+}
+
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -264,29 +414,9 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
         status = WEAR_LEVELING_FAILED;
     }
 
-    if (status != WEAR_LEVELING_FAILED) {
-        // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+    // Write out the FNV1a_64 result of the consolidated data
+    if (status != WEAR_LEVELING_FAILED && !wear_leveling_write_checksum()) {
+        status = WEAR_LEVELING_FAILED;
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -317,20 +447,23 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_START);
 
     return status;
 }
+#else
+static wear_leveling_status_t wear_leveling_consolidate_force(void);
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
 /**
  * Potential write of the current cache to the backing store.
- * Skipped if the current write log position is not at the end of the backing store.
+ * Skipped if the current write log position is not at the end of the backing store, or the checkpoint interval.
  * During this operation, there is the potential for data loss if a power loss occurs.
  *
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= (WEAR_LEVELING_LOG_END)) {
         return wear_leveling_consolidate_force();
     }
 
@@ -343,7 +476,7 @@ static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
-    bool ok = backing_store_write(wear_leveling.write_address, value);
+    bool ok = backing_store_write(BANK_ADDRESS(wear_leveling.write_address), value);
     if (!ok) {
         wl_dprintf("Failed to write to backing store\n");
         return WEAR_LEVELING_FAILED;
@@ -470,18 +603,207 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+/**
+ * Starts, or restarts, background consolidation into the bank not in use.
+ */
+static void wear_leveling_background_start(void) {
+    wear_leveling_background.state     = BACKGROUND_ERASING;
+    wear_leveling_background.bank_base = wear_leveling.bank_base == 0 ? (WEAR_LEVELING_BANK_SIZE) : 0;
+    wear_leveling_background.address   = wear_leveling_background.bank_base;
+}
+
+/**
+ * Writes the sequence number and checksum of the bank being consolidated into, then switches over to it.
+ * The checksum is written last, so that the bank is only considered valid once everything else is in place.
+ */
+static wear_leveling_status_t wear_leveling_background_commit(void) {
+    const uint32_t base     = wear_leveling_background.bank_base;
+    const uint64_t sequence = wear_leveling.sequence + 1;
+    wl_dprintf("Writing sequence and checksum\n");
+    if (!wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, sequence) || !wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), wear_leveling_checksum(wear_leveling_background.hash, sequence))) {
+        wl_dprintf("Failed to write to backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Background consolidation complete\n");
+    wear_leveling_background.state = BACKGROUND_IDLE;
+    wear_leveling.bank_base        = base;
+    wear_leveling.sequence         = sequence;
+    wear_leveling.write_address    = wear_leveling_background.write_address;
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Appends a write to the log of the bank being consolidated into, as the consolidated data already written there
+ * predates it. If it can't be logged, consolidation starts over.
+ * Pre-condition: the backing store is unlocked.
+ */
+static void wear_leveling_background_log(uint32_t address, const void *value, size_t length) {
+    // Log entries never take more than 8 bytes per byte of data, and must not fill the log
+    bool ok = wear_leveling_background.write_address + (length * 8) < (WEAR_LEVELING_LOG_END);
+    if (ok) {
+        const uint32_t bank_base     = wear_leveling.bank_base;
+        const uint32_t write_address = wear_leveling.write_address;
+        wear_leveling.bank_base      = wear_leveling_background.bank_base;
+        wear_leveling.write_address  = wear_leveling_background.write_address;
+
+        ok = wear_leveling_write_raw(address, value, length) == WEAR_LEVELING_SUCCESS;
+
+        wear_leveling_background.write_address = wear_leveling.write_address;
+        wear_leveling.bank_base                = bank_base;
+        wear_leveling.write_address            = write_address;
+    }
+
+    if (!ok) {
+        wl_dprintf("Failed to log to new bank, restarting background consolidation\n");
+        wear_leveling_background_start();
+    }
+}
+
+/**
+ * Performs one step of background consolidation, if the write log has passed the high water mark.
+ */
+wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    if (wear_leveling_background.state == BACKGROUND_IDLE) {
+        if (!wear_leveling_consolidate_pending()) {
+            return WEAR_LEVELING_SUCCESS;
+        }
+        wl_dprintf("Starting background consolidation\n");
+        wear_leveling_background_start();
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (wear_leveling_background.state == BACKGROUND_ERASING) {
+        const uint32_t end = wear_leveling_background.bank_base + (WEAR_LEVELING_BANK_SIZE);
+        if (!backing_store_erase_step(wear_leveling_background.address, end, &wear_leveling_background.address)) {
+            wl_dprintf("Failed to erase backing store\n");
+            status = WEAR_LEVELING_FAILED;
+        } else if (wear_leveling_background.address >= end) {
+            wear_leveling_background.state         = BACKGROUND_WRITING;
+            wear_leveling_background.address       = 0;
+            wear_leveling_background.write_address = (WEAR_LEVELING_LOG_START);
+            wear_leveling_background.hash          = FNV1A_64_INIT;
+        }
+    } else {
+        uint32_t offset = wear_leveling_background.address;
+        uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+        if (length > (WEAR_LEVELING_BACKGROUND_WRITE_SIZE)) {
+            length = (WEAR_LEVELING_BACKGROUND_WRITE_SIZE);
+        }
+        if (!backing_store_write_bulk(wear_leveling_background.bank_base + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / sizeof(backing_store_int_t))) {
+            wl_dprintf("Failed to write to backing store\n");
+            status = WEAR_LEVELING_FAILED;
+        } else {
+            // Hash what was actually written, as the cache may change before the consolidation completes
+            wear_leveling_background.hash = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling_background.hash);
+            if ((wear_leveling_background.address += length) >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                status = wear_leveling_background_commit();
+            }
+        }
+    }
+
+    // The bank being consolidated into is in an unknown state, but the one in use is untouched, so start over
+    if (status == WEAR_LEVELING_FAILED) {
+        wear_leveling_background_start();
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Completes a consolidation, starting one if needed, in as many steps as it takes.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    if (wear_leveling_background.state == BACKGROUND_IDLE) {
+        wl_dprintf("Starting consolidation\n");
+        wear_leveling_background_start();
+    }
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (wear_leveling_background.state != BACKGROUND_IDLE && status != WEAR_LEVELING_FAILED);
+    return status;
+}
+
+/**
+ * Checks whether a consolidation is in progress, or due to be started.
+ */
+bool wear_leveling_consolidate_pending(void) {
+    return wear_leveling_background.state != BACKGROUND_IDLE || wear_leveling.write_address >= (WEAR_LEVELING_LOG_START) + (WEAR_LEVELING_BACKGROUND_HIGH_WATER_MARK);
+}
+
+/**
+ * Completes any pending consolidation right away.
+ */
+wear_leveling_status_t wear_leveling_consolidate_finish(void) {
+    if (!wear_leveling_consolidate_pending()) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+    return wear_leveling_consolidate_force();
+}
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
+/**
+ * Window of the write log read in bulk during playback.
+ */
+typedef struct wear_leveling_playback_buffer_t {
+    backing_store_int_t values[(WEAR_LEVELING_PLAYBACK_READ_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint32_t            start;
+    uint32_t            end;
+} wear_leveling_playback_buffer_t;
+
+/**
+ * Reads a single write log value, refilling the playback buffer from the backing store when needed.
+ */
+static bool wear_leveling_playback_read(wear_leveling_playback_buffer_t *buffer, uint32_t address, backing_store_int_t *value) {
+    if (address >= (WEAR_LEVELING_BANK_SIZE)) {
+        return false;
+    }
+
+    if (address < buffer->start || address >= buffer->end) {
+        size_t count = sizeof(buffer->values) / sizeof(backing_store_int_t);
+        if (address + count * (BACKING_STORE_WRITE_SIZE) > (WEAR_LEVELING_BANK_SIZE)) {
+            count = ((WEAR_LEVELING_BANK_SIZE) - address) / (BACKING_STORE_WRITE_SIZE);
+        }
+        if (!backing_store_read_bulk(BANK_ADDRESS(address), buffer->values, count)) {
+            buffer->start = buffer->end = 0;
+            return false;
+        }
+        buffer->start = address;
+        buffer->end   = address + (uint32_t)(count * (BACKING_STORE_WRITE_SIZE));
+    }
+
+    *value = buffer->values[(address - buffer->start) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    wear_leveling_playback_buffer_t buffer          = {.start = 0, .end = 0};
+    wear_leveling_status_t          status          = WEAR_LEVELING_SUCCESS;
+    bool                            cancel_playback = false;
+    uint32_t                        address         = (WEAR_LEVELING_LOG_START);
+    while (!cancel_playback && address < (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_playback_read(&buffer, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -510,7 +832,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_playback_read(&buffer, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -530,7 +852,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_playback_read(&buffer, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -540,7 +862,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_playback_read(&buffer, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -551,7 +873,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_playback_read(&buffer, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -620,6 +942,9 @@ wear_leveling_status_t wear_leveling_init(void) {
 
     // Reset the cache
     wear_leveling_clear_cache();
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling_background.state = BACKGROUND_IDLE;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
     // Initialise the backing store
     if (!backing_store_init()) {
@@ -628,6 +953,10 @@ wear_leveling_status_t wear_leveling_init(void) {
         return WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling_select_bank();
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     // Read the previous consolidated values, then replay the existing write log so that the cache has the "live" values
     wear_leveling_status_t status = wear_leveling_read_consolidated();
     if (status == WEAR_LEVELING_FAILED) {
@@ -663,6 +992,11 @@ wear_leveling_status_t wear_leveling_erase(void) {
     // Perform the erase
     bool ret = backing_store_erase();
     wear_leveling_clear_cache();
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    wear_leveling_background.state = BACKGROUND_IDLE;
+    wear_leveling.bank_base        = 0;
+    wear_leveling.sequence         = 0;
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -699,6 +1033,13 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return WEAR_LEVELING_FAILED;
     }
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+    // Logged to the new bank first, so that it's there even if this write fills the log and completes the consolidation
+    if (wear_leveling_background.state == BACKGROUND_WRITING && address < wear_leveling_background.address) {
+        wear_leveling_background_log(address, value, length);
+    }
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
     // Perform the actual write
     wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
     switch (status) {
@@ -1,9 +1,21 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// Milliseconds without input activity before the keyboard performs background consolidation steps
+#    ifndef WEAR_LEVELING_BACKGROUND_IDLE_TIME
+#        define WEAR_LEVELING_BACKGROUND_IDLE_TIME 100
+#    endif
+// Milliseconds a consolidation may stay pending before the keyboard performs steps regardless of input activity
+#    ifndef WEAR_LEVELING_BACKGROUND_MAX_PENDING_TIME
+#        define WEAR_LEVELING_BACKGROUND_MAX_PENDING_TIME 5000
+#    endif
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 /**
  * @typedef Status returned from any wear-leveling API.
  */
@@ -52,3 +64,33 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs one step of background consolidation.
+ *
+ * Only available with WEAR_LEVELING_BACKGROUND_CONSOLIDATION. Once the write log passes the high water mark, each call
+ * either erases one sector of the bank not in use or writes WEAR_LEVELING_BACKGROUND_WRITE_SIZE bytes of consolidated
+ * data to it, so that the write log can be cleared without stalling inside wear_leveling_write(). Writes made while a
+ * consolidation is in progress do not wait for it.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the consolidation completes, otherwise status of the request
+ */
+wear_leveling_status_t wear_leveling_consolidate_step(void);
+
+/**
+ * Checks whether a background consolidation is in progress, or due to be started.
+ *
+ * Only available with WEAR_LEVELING_BACKGROUND_CONSOLIDATION.
+ *
+ * @return true if wear_leveling_consolidate_step() has work to do
+ */
+bool wear_leveling_consolidate_pending(void);
+
+/**
+ * Completes any pending background consolidation in one call, such as before shutdown or suspend.
+ *
+ * Only available with WEAR_LEVELING_BACKGROUND_CONSOLIDATION.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED if a consolidation completed, otherwise status of the request
+ */
+wear_leveling_status_t wear_leveling_consolidate_finish(void);
@@ -25,6 +25,40 @@ typedef uint64_t backing_store_int_t;
 #    error WEAR_LEVELING_LOGICAL_SIZE was not set.
 #endif
 
+// Number of bytes of write log fetched by each bulk read during playback
+#ifndef WEAR_LEVELING_PLAYBACK_READ_SIZE
+#    define WEAR_LEVELING_PLAYBACK_READ_SIZE 64
+#endif
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// The backing store is split into two banks, consolidation writes the one not in use
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+// Consolidated data, its FNV1a_64 and the bank's sequence number precede the write log
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 16)
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+// Consolidated data and its FNV1a_64 precede the write log
+#    define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + 8)
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
+// Optionally consolidate once the write log holds this many bytes, bounding playback at init
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+#    define WEAR_LEVELING_LOG_END ((WEAR_LEVELING_LOG_START) + (WEAR_LEVELING_CHECKPOINT_INTERVAL))
+#else
+#    define WEAR_LEVELING_LOG_END (WEAR_LEVELING_BANK_SIZE)
+#endif
+
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+// Number of bytes of write log after which consolidation is started in the background
+#    ifndef WEAR_LEVELING_BACKGROUND_HIGH_WATER_MARK
+#        define WEAR_LEVELING_BACKGROUND_HIGH_WATER_MARK ((((WEAR_LEVELING_LOG_END) - (WEAR_LEVELING_LOG_START)) / 4) * 3)
+#    endif
+// Number of bytes of consolidated data written by each background step
+#    ifndef WEAR_LEVELING_BACKGROUND_WRITE_SIZE
+#        define WEAR_LEVELING_BACKGROUND_WRITE_SIZE 64
+#    endif
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+
 #ifdef WEAR_LEVELING_DEBUG_OUTPUT
 #    include <debug.h>
 #    define bs_dprintf(...) dprintf("Backing store: " __VA_ARGS__)
@@ -63,11 +97,21 @@ typedef uint64_t backing_store_int_t;
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Total backing size must be at least twice the size of the logical size");
 STATIC_ASSERT(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 STATIC_ASSERT(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
+STATIC_ASSERT(WEAR_LEVELING_PLAYBACK_READ_SIZE >= BACKING_STORE_WRITE_SIZE && WEAR_LEVELING_PLAYBACK_READ_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback read size must be a multiple of write size");
+STATIC_ASSERT(WEAR_LEVELING_LOG_END <= WEAR_LEVELING_BANK_SIZE, "Checkpoint interval must fit within the backing size");
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+STATIC_ASSERT(WEAR_LEVELING_BANK_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2) && WEAR_LEVELING_BANK_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Background consolidation needs a backing size of at least four times the logical size, and a multiple of twice it");
+STATIC_ASSERT(WEAR_LEVELING_BACKGROUND_WRITE_SIZE >= BACKING_STORE_WRITE_SIZE && WEAR_LEVELING_BACKGROUND_WRITE_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Background write size must be a multiple of write size");
+STATIC_ASSERT((WEAR_LEVELING_LOG_START) + (WEAR_LEVELING_BACKGROUND_HIGH_WATER_MARK) < WEAR_LEVELING_LOG_END, "Background high water mark must be less than the write log size");
+#endif // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+#ifdef WEAR_LEVELING_BACKGROUND_CONSOLIDATION
+bool backing_store_erase_step(uint32_t address, uint32_t end, uint32_t* next); // erases the sector starting at address without going past end, next is set to the address following it
+#endif                                                                          // WEAR_LEVELING_BACKGROUND_CONSOLIDATION
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
@@ -0,0 +1,216 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+}
+
+using testing::_;
+
+class LayerLookupCache : public TestFixture {
+   public:
+    /* Counts every keymap read, whether from the cache filling in an entry or from the reference scan. */
+    void get_keycode(const layer_t layer, const keypos_t position, uint16_t* result) const override {
+        keymap_reads++;
+        TestFixture::get_keycode(layer, position, result);
+    }
+
+   protected:
+    std::mt19937     rng{0x514D4B};
+    mutable unsigned keymap_reads = 0;
+
+    /* The fixture keymap shadows the dynamic keymap, so mirror it after every write. Keymap changes then only reach
+     * the cache through the dynamic keymap. */
+    void sync_keymap() {
+        keymap.clear();
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    add_key(KeymapKey(layer, col, row, dynamic_keymap_get_keycode(layer, row, col)));
+                }
+            }
+        }
+    }
+
+    void set_keycode(uint8_t layer, uint8_t row, uint8_t col, uint16_t keycode) {
+        dynamic_keymap_set_keycode(layer, row, col, keycode);
+        sync_keymap();
+    }
+
+    /* Fill every layer with a random mix of transparent and opaque keys. */
+    void set_random_keymap(unsigned transparent_percent) {
+        std::uniform_int_distribution<unsigned> percent(0, 99);
+        for (uint8_t layer = 0; layer < MAX_LAYER; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    uint16_t keycode = percent(rng) < transparent_percent ? KC_TRANSPARENT : (uint16_t)(KC_A + layer);
+                    dynamic_keymap_set_keycode(layer, row, col, keycode);
+                }
+            }
+        }
+        sync_keymap();
+    }
+
+    /* Reference implementation: the uncached top-down layer scan. */
+    static uint8_t scan_layers(keypos_t key) {
+        layer_state_t layers = layer_state | default_layer_state;
+        for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+            if ((layers & ((layer_state_t)1 << i)) && action_for_key(i, key).code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    void expect_all_keys_match_scan() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keypos_t key = {.col = col, .row = row};
+                EXPECT_EQ(layer_switch_get_layer(key), scan_layers(key)) << "row " << +row << " col " << +col << " layer_state " << layer_state;
+            }
+        }
+    }
+};
+
+TEST_F(LayerLookupCache, MatchesScanForRandomLayerStates) {
+    TestDriver                             driver;
+    std::uniform_int_distribution<uint32_t> state_dist;
+
+    set_random_keymap(70);
+
+    for (int i = 0; i < 200; i++) {
+        layer_state_set((layer_state_t)state_dist(rng));
+        expect_all_keys_match_scan();
+        /* A second pass is served from the cache and must not diverge. */
+        expect_all_keys_match_scan();
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, MatchesScanForRandomDefaultLayerStates) {
+    TestDriver                             driver;
+    std::uniform_int_distribution<uint32_t> state_dist;
+
+    set_random_keymap(85);
+
+    for (int i = 0; i < 100; i++) {
+        default_layer_set((layer_state_t)state_dist(rng));
+        layer_state_set((layer_state_t)state_dist(rng));
+        expect_all_keys_match_scan();
+    }
+    default_layer_set(0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, TracksDirectLayerStateWrites) {
+    TestDriver driver;
+
+    set_random_keymap(50);
+
+    /* Split slaves assign the layer state directly, bypassing layer_state_set(). */
+    layer_state = 0;
+    expect_all_keys_match_scan();
+    layer_state = (layer_state_t)0xAAAAAAAA;
+    expect_all_keys_match_scan();
+    layer_state = (layer_state_t)0x55555555;
+    expect_all_keys_match_scan();
+    layer_state = 0;
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, InvalidatesOnLayerChange) {
+    TestDriver driver;
+    keypos_t   key = {.col = 0, .row = 0};
+
+    set_keycode(0, 0, 0, KC_A);
+    set_keycode(1, 0, 0, KC_B);
+    layer_state_set(0b01);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, InvalidatesOnDynamicKeymapWrite) {
+    TestDriver driver;
+    keypos_t   key = {.col = 1, .row = 2};
+
+    set_keycode(0, 2, 1, KC_A);
+    set_keycode(1, 2, 1, KC_B);
+    layer_state_set(0b11);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    set_keycode(1, 2, 1, KC_TRANSPARENT);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    set_keycode(1, 2, 1, KC_C);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, InvalidatesOnViaKeymapWrite) {
+    TestDriver driver;
+    keypos_t   key = {.col = 0, .row = 0};
+
+    set_keycode(0, 0, 0, KC_A);
+    set_keycode(1, 0, 0, KC_B);
+    layer_state_set(0b11);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    /* VIA keymap buffer writes (and bulk writes) hold big endian keycodes, layer 1 starting after all of layer 0. */
+    uint16_t offset     = MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t  data[2][2] = {{KC_TRANSPARENT >> 8, KC_TRANSPARENT & 0xFF}, {KC_C >> 8, KC_C & 0xFF}};
+
+    dynamic_keymap_set_buffer(offset, sizeof(data[0]), data[0]);
+    sync_keymap();
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    dynamic_keymap_set_buffer(offset, sizeof(data[1]), data[1]);
+    sync_keymap();
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, ReadsKeymapLessThanScan) {
+    TestDriver driver;
+
+    set_random_keymap(70);
+    layer_state_set((layer_state_t)0xFF);
+
+    keymap_reads = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            scan_layers({.col = col, .row = row});
+        }
+    }
+    unsigned scan_reads = keymap_reads;
+    EXPECT_GT(scan_reads, (unsigned)(MATRIX_ROWS * MATRIX_COLS));
+
+    /* Filling the cache scans the layers once per key, later lookups don't touch the keymap at all. */
+    for (int pass = 0; pass < 3; pass++) {
+        keymap_reads = 0;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                layer_switch_get_layer({.col = col, .row = row});
+            }
+        }
+        EXPECT_EQ(keymap_reads, pass == 0 ? scan_reads : 0) << "pass " << pass;
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
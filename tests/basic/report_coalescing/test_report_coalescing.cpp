@@ -0,0 +1,162 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class ReportCoalescing : public TestFixture {};
+
+TEST_F(ReportCoalescing, ChordIsMerged) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+
+    set_keymap({key_a, key_b, key_c});
+
+    /* The first report of the interval is sent straight away, the rest of the chord is merged. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Releases are never held back, even within the interval of the last report. */
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, TapsAreNotLost) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    /* Every press is followed by its own release. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    tap_key(key_b);
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Repeated taps of the same key within one interval are all seen. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    tap_key(key_a);
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, ReleasesAreNotHeld) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Nothing runs host_task() during a blocking wait, so the releases must already have been sent. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_code(KC_A);
+    tap_code(KC_B);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Same for mouse buttons. */
+    report_mouse_t report = {.buttons = 1};
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 0));
+    host_mouse_send(&report);
+    report.buttons = 0;
+    host_mouse_send(&report);
+    VERIFY_AND_CLEAR(driver);
+
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+}
+
+TEST_F(ReportCoalescing, ModifierOrderingIsKept) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    auto       key_a     = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({key_shift, key_a});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, MouseDeltasAreSummed) {
+    TestDriver     driver;
+    InSequence     s;
+    report_mouse_t report = {};
+
+    EXPECT_MOUSE_REPORT(driver, (10, -5, 0, 1, 0));
+    EXPECT_MOUSE_REPORT(driver, (40, -20, 0, 4, 0));
+    EXPECT_MOUSE_REPORT(driver, (3, 0, 0, 0, 1));
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 0));
+    for (int i = 0; i < 5; i++) {
+        report.x = 10;
+        report.y = -5;
+        report.v = 1;
+        host_mouse_send(&report);
+    }
+    /* A button change is never merged with the movement before it. */
+    report = (report_mouse_t){.buttons = 1, .x = 1};
+    host_mouse_send(&report);
+    report.x = 2;
+    host_mouse_send(&report);
+    report = (report_mouse_t){};
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    host_mouse_send(&report);
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, SaturatedMouseDeltasAreNotMerged) {
+    TestDriver     driver;
+    report_mouse_t report = {.x = MOUSE_REPORT_XY_MAX};
+    int            total  = 0;
+
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(3).WillRepeatedly([&total](report_mouse_t& sent) { total += sent.x; });
+    for (int i = 0; i < 3; i++) {
+        host_mouse_send(&report);
+    }
+    idle_for(HOST_REPORT_COALESCING_INTERVAL + 1);
+    EXPECT_EQ(total, 3 * MOUSE_REPORT_XY_MAX);
+    VERIFY_AND_CLEAR(driver);
+}
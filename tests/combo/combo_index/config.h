@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define COMBO_INDEX_ENABLE
+// Few buckets so that unrelated combos share them
+#define COMBO_INDEX_BUCKETS 4
+// Few key bits so that keys outside combos can share them with combo keys
+#define COMBO_INDEX_KEY_BITS 16
@@ -0,0 +1,107 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "process_combo.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class ComboIndex : public TestFixture {};
+
+TEST_F(ComboIndex, two_key_combo_tapped) {
+    TestDriver driver;
+    KeymapKey  key_z(0, 0, 1, KC_Z);
+    KeymapKey  key_x(0, 0, 2, KC_X);
+    set_keymap({key_z, key_x});
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_z, key_x});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, longest_overlapping_combo_wins) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    KeymapKey  key_i(0, 0, 3, KC_I);
+    set_keymap({key_y, key_u, key_i});
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u, key_i});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, keys_sharing_a_bucket) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    KeymapKey  key_e(0, 0, 2, KC_E);
+    set_keymap({key_a, key_e});
+
+    EXPECT_REPORT(driver, (KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_e});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, keys_outside_combos_pass_through) {
+    TestDriver driver;
+    KeymapKey  key_p(0, 0, 1, KC_P);
+    KeymapKey  key_y(0, 0, 2, KC_Y);
+    set_keymap({key_p, key_y});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_p);
+    tap_key(key_y);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, keys_sharing_a_key_bit_pass_through) {
+    TestDriver driver;
+    // KC_Q shares its key bit with KC_A, so it is checked against the combos in its bucket
+    KeymapKey key_q(0, 0, 1, KC_Q);
+    KeymapKey key_e(0, 0, 2, KC_E);
+    set_keymap({key_q, key_e});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_Q));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_q);
+    tap_key(key_e);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboIndex, rebuilt_after_invalidate) {
+    TestDriver driver;
+    KeymapKey  key_z(0, 0, 1, KC_Z);
+    KeymapKey  key_x(0, 0, 2, KC_X);
+    set_keymap({key_z, key_x});
+
+    combo_index_invalidate();
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_z, key_x});
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,18 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+enum combos { yu, yui, zx, ae };
+
+uint16_t const yu_combo[]  = {KC_Y, KC_U, COMBO_END};
+uint16_t const yui_combo[] = {KC_Y, KC_U, KC_I, COMBO_END};
+uint16_t const zx_combo[]  = {KC_Z, KC_X, COMBO_END};
+uint16_t const ae_combo[]  = {KC_A, KC_E, COMBO_END}; // both keys hash to the same bucket
+
+// clang-format off
+combo_t key_combos[] = {
+    [yu]  = COMBO(yu_combo, KC_1),
+    [yui] = COMBO(yui_combo, KC_2),
+    [zx]  = COMBO(zx_combo, KC_3),
+    [ae]  = COMBO(ae_combo, KC_4),
+};
+// clang-format on
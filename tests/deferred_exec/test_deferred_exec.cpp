@@ -0,0 +1,301 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+using testing::ElementsAre;
+
+namespace {
+
+struct invocation_t {
+    uintptr_t id;
+    uint32_t  trigger_time;
+    uint32_t  now;
+};
+
+constexpr size_t TABLE_SIZE = 200;
+
+std::vector<invocation_t> invocations;
+
+// Callbacks can't capture, so the reentrant ones reach the table under test through this
+deferred_executor_t *current_table = nullptr;
+
+uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({(uintptr_t)cb_arg, trigger_time, timer_read32()});
+    return 0;
+}
+
+uint32_t repeat_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    return 5;
+}
+
+std::vector<uintptr_t> invoked_ids(void) {
+    std::vector<uintptr_t> ids;
+    for (auto &invocation : invocations) {
+        ids.push_back(invocation.id);
+    }
+    return ids;
+}
+
+} // namespace
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(1000);
+        invocations.clear();
+        std::fill(std::begin(table), std::end(table), deferred_executor_t{});
+        last_exec     = 0;
+        current_table = table;
+    }
+
+    void run_task(void) {
+        deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            run_task();
+        }
+    }
+
+    deferred_token defer(uint32_t delay_ms, uintptr_t id, deferred_exec_callback callback = record_callback) {
+        return defer_exec_advanced(table, TABLE_SIZE, delay_ms, callback, (void *)id);
+    }
+
+    deferred_executor_t table[TABLE_SIZE];
+    uint32_t            last_exec;
+};
+
+TEST_F(DeferredExec, FiresOnceAtTriggerTime) {
+    EXPECT_NE(defer(10, 1), INVALID_DEFERRED_TOKEN);
+
+    run_for(9);
+    EXPECT_TRUE(invocations.empty());
+
+    run_for(1);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].trigger_time, 1010);
+    EXPECT_EQ(invocations[0].now, 1010);
+
+    run_for(100);
+    EXPECT_EQ(invocations.size(), 1);
+
+    uint32_t next;
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &next));
+}
+
+TEST_F(DeferredExec, RejectsInvalidRequests) {
+    EXPECT_EQ(defer(0, 1), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(table, TABLE_SIZE, 10, nullptr, nullptr), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec_advanced(table, 0, 10, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, INVALID_DEFERRED_TOKEN));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, INVALID_DEFERRED_TOKEN, 10));
+}
+
+TEST_F(DeferredExec, FullTableRejectsFurtherExecutors) {
+    for (size_t i = 0; i < TABLE_SIZE; ++i) {
+        EXPECT_NE(defer(100 + i, i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer(10, TABLE_SIZE), INVALID_DEFERRED_TOKEN);
+
+    run_for(100);
+    EXPECT_EQ(invocations.size(), 1);
+    EXPECT_NE(defer(10, TABLE_SIZE), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, LateTaskRunsExecutorsInTriggerOrder) {
+    defer(50, 5);
+    defer(10, 1);
+    defer(30, 3);
+    defer(20, 2);
+    defer(40, 4);
+
+    // The main loop stalled past all of them
+    advance_time(100);
+    run_task();
+
+    EXPECT_THAT(invoked_ids(), ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST_F(DeferredExec, ManyExecutorsFireExactlyOnTime) {
+    // Pseudo-random delays, so that entries are inserted all over the heap
+    uint32_t seed = 1;
+    for (size_t i = 0; i < TABLE_SIZE; ++i) {
+        seed = seed * 1103515245 + 12345;
+        EXPECT_NE(defer(1 + (seed >> 16) % 500, i), INVALID_DEFERRED_TOKEN);
+    }
+
+    uint32_t next;
+    ASSERT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &next));
+    run_for(500);
+
+    ASSERT_EQ(invocations.size(), TABLE_SIZE);
+    EXPECT_EQ(invocations[0].trigger_time, next);
+    for (size_t i = 0; i < invocations.size(); ++i) {
+        EXPECT_EQ(invocations[i].now, invocations[i].trigger_time) << "executor " << invocations[i].id << " fired late";
+        if (i > 0) {
+            EXPECT_GE(invocations[i].trigger_time, invocations[i - 1].trigger_time);
+        }
+    }
+}
+
+TEST_F(DeferredExec, NextTriggerTracksSoonestExecutor) {
+    uint32_t next = 0;
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &next));
+
+    defer(30, 1);
+    deferred_token soonest = defer(10, 2);
+    defer(20, 3);
+    EXPECT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &next));
+    EXPECT_EQ(next, 1010);
+
+    cancel_deferred_exec_advanced(table, TABLE_SIZE, soonest);
+    EXPECT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &next));
+    EXPECT_EQ(next, 1020);
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToPreviousTrigger) {
+    defer(5, 1, repeat_callback);
+
+    // Late by 3ms for the first invocation, the following ones stay on the original schedule
+    advance_time(8);
+    run_task();
+    run_for(10);
+
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[0].trigger_time, 1005);
+    EXPECT_EQ(invocations[1].trigger_time, 1010);
+    EXPECT_EQ(invocations[2].trigger_time, 1015);
+    EXPECT_EQ(invocations[1].now, 1010);
+}
+
+TEST_F(DeferredExec, RepeatingExecutorCatchesUpGradually) {
+    defer(5, 1, repeat_callback);
+
+    // Far behind schedule: each task run invokes at most as many callbacks as there are executors, rather than
+    // catching up all at once
+    advance_time(50);
+    run_task();
+    EXPECT_EQ(invocations.size(), 1);
+    run_for(1);
+    EXPECT_EQ(invocations.size(), 2);
+}
+
+TEST_F(DeferredExec, CancelledExecutorNeverFires) {
+    defer(10, 1);
+    deferred_token token = defer(20, 2);
+    defer(30, 3);
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, token, 10));
+
+    run_for(50);
+    EXPECT_THAT(invoked_ids(), ElementsAre(1, 3));
+}
+
+TEST_F(DeferredExec, ExtendPostponesFromNow) {
+    deferred_token token = defer(10, 1);
+    defer(15, 2);
+
+    run_for(5);
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, token, 20));
+    run_for(30);
+
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[0].id, 2);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].trigger_time, 1025);
+}
+
+namespace {
+
+deferred_token reentrant_victim = INVALID_DEFERRED_TOKEN;
+deferred_token reentrant_self   = INVALID_DEFERRED_TOKEN;
+
+uint32_t cancel_other_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(current_table, TABLE_SIZE, reentrant_victim));
+    return 0;
+}
+
+uint32_t requeue_self_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(current_table, TABLE_SIZE, reentrant_self));
+    reentrant_self = defer_exec_advanced(current_table, TABLE_SIZE, 50, record_callback, (void *)((uintptr_t)cb_arg + 100));
+    // Ignored, as this executor was cancelled
+    return 1;
+}
+
+uint32_t extend_self_callback(uint32_t trigger_time, void *cb_arg) {
+    record_callback(trigger_time, cb_arg);
+    EXPECT_TRUE(extend_deferred_exec_advanced(current_table, TABLE_SIZE, reentrant_self, 10));
+    return 0;
+}
+
+} // namespace
+
+TEST_F(DeferredExec, CallbackCancelsAnotherDueExecutor) {
+    defer(10, 1, cancel_other_callback);
+    reentrant_victim = defer(11, 2);
+    defer(12, 3);
+
+    // All three are due within the same task run
+    advance_time(20);
+    run_task();
+    run_for(10);
+
+    EXPECT_THAT(invoked_ids(), ElementsAre(1, 3));
+}
+
+TEST_F(DeferredExec, CallbackDefersNewExecutor) {
+    defer(10, 1, requeue_self_callback);
+    reentrant_self = table[0].token;
+    defer(20, 2);
+
+    run_for(100);
+
+    EXPECT_THAT(invoked_ids(), ElementsAre(1, 2, 101));
+    EXPECT_EQ(invocations[2].trigger_time, 1060);
+}
+
+TEST_F(DeferredExec, CallbackExtendsItself) {
+    reentrant_self = defer(10, 1, extend_self_callback);
+
+    run_for(100);
+
+    // The extension takes the place of the zero return
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].trigger_time, 1010);
+}
+
+TEST_F(DeferredExec, BasicApi) {
+    last_exec = 0;
+    deferred_token token = defer_exec(10, record_callback, (void *)1);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    uint32_t next;
+    EXPECT_TRUE(deferred_exec_next_trigger(&next));
+    EXPECT_EQ(next, 1010);
+
+    for (int i = 0; i < 10; ++i) {
+        advance_time(1);
+        deferred_exec_task();
+    }
+    EXPECT_THAT(invoked_ids(), ElementsAre(1));
+    EXPECT_FALSE(deferred_exec_next_trigger(&next));
+}
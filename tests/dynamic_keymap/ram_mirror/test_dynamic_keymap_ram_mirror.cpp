@@ -0,0 +1,99 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "nvm_dynamic_keymap.h"
+#include "suspend.h"
+
+void shutdown_quantum(bool jump_to_bootloader);
+}
+
+class DynamicKeymapRamMirror : public TestFixture {
+   protected:
+    void SetUp() override {
+        // Start from a keymap that is in sync with EEPROM
+        dynamic_keymap_flush();
+        dynamic_keymap_set_keycode(0, 0, 0, KC_NO);
+        dynamic_keymap_set_keycode(1, 2, 3, KC_NO);
+        dynamic_keymap_flush();
+    }
+
+    void write_keycodes(void) {
+        dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+        dynamic_keymap_set_keycode(1, 2, 3, KC_B);
+    }
+
+    void expect_keycodes_read_back(void) {
+        EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+        EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_B);
+    }
+
+    void expect_eeprom(uint16_t first, uint16_t second) {
+        EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), first);
+        EXPECT_EQ(nvm_dynamic_keymap_read_keycode(1, 2, 3), second);
+    }
+};
+
+TEST_F(DynamicKeymapRamMirror, WritesBackOnceEditsStop) {
+    TestDriver driver;
+
+    write_keycodes();
+    expect_keycodes_read_back();
+    expect_eeprom(KC_NO, KC_NO);
+
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY - 10);
+    expect_eeprom(KC_NO, KC_NO);
+
+    // Every further edit restarts the delay
+    dynamic_keymap_set_keycode(1, 2, 3, KC_B);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_C);
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY - 10);
+    expect_eeprom(KC_NO, KC_NO);
+
+    idle_for(20);
+    expect_eeprom(KC_A, KC_B);
+    expect_keycodes_read_back();
+}
+
+TEST_F(DynamicKeymapRamMirror, WritesBackOnShutdown) {
+    TestDriver driver;
+
+    write_keycodes();
+    expect_eeprom(KC_NO, KC_NO);
+
+    shutdown_quantum(false);
+    expect_eeprom(KC_A, KC_B);
+    expect_keycodes_read_back();
+}
+
+TEST_F(DynamicKeymapRamMirror, WritesBackOnSuspend) {
+    TestDriver driver;
+
+    write_keycodes();
+    expect_eeprom(KC_NO, KC_NO);
+
+    suspend_power_down_quantum();
+    expect_eeprom(KC_A, KC_B);
+    expect_keycodes_read_back();
+}
+
+TEST_F(DynamicKeymapRamMirror, BufferWritesAreMirrored) {
+    TestDriver driver;
+
+    // Layer 0, row 0, column 0, big endian
+    uint8_t data[2] = {KC_C >> 8, KC_C & 0xFF};
+    dynamic_keymap_set_buffer(0, sizeof(data), data);
+
+    uint8_t read[2] = {0};
+    dynamic_keymap_get_buffer(0, sizeof(read), read);
+    EXPECT_EQ(read[0], data[0]);
+    EXPECT_EQ(read[1], data[1]);
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_NO);
+
+    dynamic_keymap_flush();
+    EXPECT_EQ(nvm_dynamic_keymap_read_keycode(0, 0, 0), KC_C);
+}
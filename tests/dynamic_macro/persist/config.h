@@ -0,0 +1,10 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_MACRO_SIZE 16
+#define DYNAMIC_MACRO_PERSIST
+#define TRANSIENT_EEPROM_SIZE 512
@@ -0,0 +1,116 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+class DynamicMacroPersist : public TestFixture {
+   protected:
+    KeymapKey rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey stop  = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey play1 = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey play2 = KeymapKey(0, 4, 0, DM_PLY2);
+    KeymapKey key_a = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b = KeymapKey(0, 6, 0, KC_B);
+
+    void SetUp() override {
+        set_keymap({rec1, rec2, stop, play1, play2, key_a, key_b});
+    }
+
+    void record(TestDriver& driver, KeymapKey& start, std::function<void()> keys) {
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+        tap_key(start);
+        keys();
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    /* RAM is lost on reboot, while the transient EEPROM is kept. */
+    void reboot() {
+        dynamic_macro_init();
+    }
+};
+
+TEST_F(DynamicMacroPersist, MacrosSurviveReboot) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() {
+        tap_key(key_a);
+        tap_key(key_b);
+    });
+    record(driver, rec2, [&]() { tap_key(key_b); });
+    reboot();
+
+    {
+        InSequence s;
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    tap_key(play2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroPersist, RerecordingReplacesSavedMacro) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() { tap_key(key_a); });
+    record(driver, rec1, [&]() { tap_key(key_b); });
+    reboot();
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroPersist, ClearingEepromDiscardsMacros) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() { tap_key(key_a); });
+    eeconfig_init();
+    reboot();
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacroPersist, RecordingAfterClearingEepromSavesBothMacros) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() { tap_key(key_a); });
+    eeconfig_init();
+
+    // Macro 1 is still in RAM, and is saved again along with macro 2
+    record(driver, rec2, [&]() { tap_key(key_b); });
+    reboot();
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,111 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   protected:
+    KeymapKey rec1  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey rec2  = KeymapKey(0, 1, 0, DM_REC2);
+    KeymapKey stop  = KeymapKey(0, 2, 0, DM_RSTP);
+    KeymapKey play1 = KeymapKey(0, 3, 0, DM_PLY1);
+    KeymapKey play2 = KeymapKey(0, 4, 0, DM_PLY2);
+    KeymapKey key_a = KeymapKey(0, 5, 0, KC_A);
+    KeymapKey key_b = KeymapKey(0, 6, 0, KC_B);
+
+    void SetUp() override {
+        set_keymap({rec1, rec2, stop, play1, play2, key_a, key_b});
+    }
+
+    void record(TestDriver& driver, KeymapKey& start, std::function<void()> keys) {
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A)).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_B)).Times(AnyNumber());
+        tap_key(start);
+        keys();
+        tap_key(stop);
+        VERIFY_AND_CLEAR(driver);
+    }
+};
+
+TEST_F(DynamicMacro, RecordAndPlay) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() {
+        tap_key(key_a);
+        tap_key(key_b);
+    });
+
+    {
+        InSequence s;
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    }
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, HoldsMoreEventsThanMacroSize) {
+    TestDriver driver;
+    const int  taps = DYNAMIC_MACRO_SIZE;
+
+    record(driver, rec1, [&]() {
+        for (int i = 0; i < taps; i++) {
+            tap_key(key_a);
+        }
+    });
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(taps);
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, TrimsKeysHeldWhenStopping) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() {
+        tap_key(key_a);
+        key_b.press();
+        run_one_scan_loop();
+    });
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, MacrosDoNotOverlap) {
+    TestDriver driver;
+
+    record(driver, rec1, [&]() { tap_key(key_a); });
+    record(driver, rec2, [&]() { tap_key(key_b); });
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    tap_key(play1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    tap_key(play2);
+    VERIFY_AND_CLEAR(driver);
+}
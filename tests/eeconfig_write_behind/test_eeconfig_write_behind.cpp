@@ -0,0 +1,104 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "eeconfig.h"
+#include "eeprom.h"
+#include "keycode_config.h"
+#include "nvm_eeconfig.h"
+}
+
+// Offsets within eeprom_core_t, see nvm_eeprom_eeconfig_internal.h (which can't be included from C++)
+#define EECONFIG_MAGIC ((uint16_t*)0)
+#define EECONFIG_KEYMAP ((uint16_t*)4)
+#define EECONFIG_HANDEDNESS ((uint8_t*)14)
+#define EECONFIG_USER ((uint32_t*)19)
+
+class EeconfigWriteBehind : public TestFixture {
+   protected:
+    void SetUp() override {
+        eeconfig_init_quantum();
+        eeconfig_flush();
+    }
+
+    TestDriver driver;
+
+    // Reads what has actually reached EEPROM, bypassing the write-behind cache
+    static uint16_t stored_keymap(void) {
+        return eeprom_read_word(EECONFIG_KEYMAP);
+    }
+
+    static uint32_t stored_user(void) {
+        return eeprom_read_dword(EECONFIG_USER);
+    }
+};
+
+TEST_F(EeconfigWriteBehind, UpdateIsHeldUntilIdle) {
+    keymap_config_t config = {.raw = 0};
+    config.nkro            = true;
+    const uint16_t before  = stored_keymap();
+
+    eeconfig_update_keymap(&config);
+
+    keymap_config_t read_back;
+    eeconfig_read_keymap(&read_back);
+    EXPECT_EQ(read_back.raw, config.raw) << "Reads should see the pending update";
+    EXPECT_EQ(stored_keymap(), before) << "Update should not have been written yet";
+
+    idle_for(EECONFIG_WRITE_BEHIND_DELAY - 10);
+    EXPECT_EQ(stored_keymap(), before);
+
+    idle_for(20);
+    EXPECT_EQ(stored_keymap(), config.raw);
+}
+
+TEST_F(EeconfigWriteBehind, RapidUpdatesAreCoalesced) {
+    const uint32_t before = stored_user();
+
+    // Keep updating more often than the delay, as when holding down a brightness key
+    for (uint32_t i = 1; i <= 20; ++i) {
+        eeconfig_update_user(i);
+        idle_for(EECONFIG_WRITE_BEHIND_DELAY / 2);
+        EXPECT_EQ(stored_user(), before) << "Nothing should be written while updates keep arriving";
+    }
+
+    idle_for(EECONFIG_WRITE_BEHIND_DELAY);
+    EXPECT_EQ(stored_user(), 20);
+    EXPECT_EQ(eeconfig_read_user(), 20);
+}
+
+TEST_F(EeconfigWriteBehind, FlushWritesImmediately) {
+    eeconfig_update_user(0x12345678);
+    eeconfig_update_handedness(true);
+    EXPECT_NE(stored_user(), 0x12345678);
+
+    eeconfig_flush();
+    EXPECT_EQ(stored_user(), 0x12345678);
+    EXPECT_EQ(eeprom_read_byte(EECONFIG_HANDEDNESS), 1);
+}
+
+TEST_F(EeconfigWriteBehind, UnchangedUpdateIsNotPending) {
+    eeconfig_update_user(0xCAFE);
+    eeconfig_flush();
+
+    // Writing the same value again must not restart the delay or write anything
+    eeprom_update_dword(EECONFIG_USER, 0xBEEF);
+    eeconfig_update_user(0xCAFE);
+    idle_for(EECONFIG_WRITE_BEHIND_DELAY * 2);
+    EXPECT_EQ(stored_user(), 0xBEEF);
+}
+
+TEST_F(EeconfigWriteBehind, ResetDiscardsPendingUpdates) {
+    eeconfig_update_user(0xA5A5A5A5);
+
+    eeconfig_init_quantum();
+    EXPECT_TRUE(eeconfig_is_enabled());
+    EXPECT_EQ(eeconfig_read_user(), 0);
+
+    idle_for(EECONFIG_WRITE_BEHIND_DELAY * 2);
+    EXPECT_EQ(stored_user(), 0);
+    EXPECT_EQ(eeprom_read_word(EECONFIG_MAGIC), EECONFIG_MAGIC_NUMBER);
+}
@@ -0,0 +1,264 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_draw.h"
+#include "qp_surface.h"
+#include "qff.h"
+#include "qp_internal_driver.h"
+}
+
+#define SURFACE_WIDTH 128
+#define SURFACE_HEIGHT 16
+#define GLYPH_HEIGHT 12
+
+/* Builds a 1bpp ascii-only QFF font in memory, with a pixel pattern derived from the seed. */
+class TestFont {
+   public:
+    explicit TestFont(uint8_t seed) : seed(seed) {
+        std::vector<uint8_t> glyph_data;
+        std::vector<uint32_t> glyph_info;
+        for (uint32_t cp = 0x20; cp < 0x7F; cp++) {
+            glyph_info.push_back((uint32_t)glyph_data.size() << QFF_GLYPH_WIDTH_BITS | width(cp));
+            std::vector<uint8_t> bytes((width(cp) * GLYPH_HEIGHT + 7) / 8, 0);
+            for (uint16_t i = 0; i < width(cp) * GLYPH_HEIGHT; i++) {
+                if (pixel(cp, i % width(cp), i / width(cp))) bytes[i / 8] |= 1 << (i % 8);
+            }
+            glyph_data.insert(glyph_data.end(), bytes.begin(), bytes.end());
+        }
+
+        block_header(0x00, 20);
+        u24(QFF_MAGIC);
+        u8(0x01);
+        size_t total_size_pos = data.size();
+        u32(0);
+        u32(0);
+        u8(GLYPH_HEIGHT);
+        u8(1);  // has ascii table
+        u16(0); // no unicode glyphs
+        u8(0);  // GRAYSCALE_1BPP
+        u8(0);
+        u8(0); // uncompressed
+        u8(0);
+
+        block_header(0x01, 95 * 3);
+        for (uint32_t info : glyph_info) u24(info);
+
+        block_header(0x04, glyph_data.size());
+        data.insert(data.end(), glyph_data.begin(), glyph_data.end());
+
+        uint32_t total = data.size();
+        memcpy(&data[total_size_pos], &total, sizeof(total));
+        total = ~total;
+        memcpy(&data[total_size_pos + 4], &total, sizeof(total));
+    }
+
+    static uint8_t width(uint32_t cp) {
+        return 6 + cp % 5;
+    }
+
+    bool pixel(uint32_t cp, uint16_t x, uint16_t y) const {
+        return ((cp * 31 + x * 7 + y * 13 + seed) % 3) == 0;
+    }
+
+    std::vector<uint8_t> data;
+
+   private:
+    uint8_t seed;
+
+    void u8(uint32_t v) {
+        data.push_back(v & 0xFF);
+    }
+    void u16(uint32_t v) {
+        u8(v);
+        u8(v >> 8);
+    }
+    void u24(uint32_t v) {
+        u16(v);
+        u8(v >> 16);
+    }
+    void u32(uint32_t v) {
+        u16(v);
+        u16(v >> 16);
+    }
+    void block_header(uint8_t type_id, uint32_t length) {
+        u8(type_id);
+        u8(~type_id);
+        u24(length);
+    }
+};
+
+class GlyphCache : public TestFixture {
+   protected:
+    /* Surfaces can't be released, share one across all tests. */
+    static uint16_t         framebuffer[SURFACE_WIDTH * SURFACE_HEIGHT];
+    static painter_device_t surface;
+
+    void SetUp() override {
+        if (!surface) {
+            surface = qp_make_rgb565_surface(SURFACE_WIDTH, SURFACE_HEIGHT, framebuffer);
+            ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+        }
+        qp_internal_glyph_cache_invalidate();
+    }
+
+    void clear_surface() {
+        memset(framebuffer, 0x55, sizeof(framebuffer));
+    }
+
+    /* Draws with fg/bg either white/black or black/white. */
+    int16_t draw(painter_font_handle_t font, const char *str, bool inverted = false) {
+        uint8_t fg = inverted ? 0 : 255;
+        return qp_drawtext_recolor(surface, 0, 0, font, str, 0, 0, fg, 0, 0, 255 - fg);
+    }
+
+    void expect_rendered(const TestFont &font, const char *str, bool inverted = false) {
+        uint16_t x = 0;
+        for (const char *c = str; *c; c++) {
+            for (uint16_t gy = 0; gy < GLYPH_HEIGHT; gy++) {
+                for (uint16_t gx = 0; gx < TestFont::width(*c); gx++) {
+                    uint16_t expected = (font.pixel(*c, gx, gy) != inverted) ? 0xFFFF : 0x0000;
+                    ASSERT_EQ(framebuffer[gy * SURFACE_WIDTH + x + gx], expected) << "glyph '" << *c << "' at " << gx << "," << gy;
+                }
+            }
+            x += TestFont::width(*c);
+        }
+    }
+};
+
+uint16_t         GlyphCache::framebuffer[SURFACE_WIDTH * SURFACE_HEIGHT];
+painter_device_t GlyphCache::surface;
+
+TEST_F(GlyphCache, CachedRenderMatchesDecodedRender) {
+    TestFont              font(0);
+    painter_font_handle_t handle = qp_load_font_mem(font.data.data());
+    ASSERT_NE(handle, nullptr);
+
+    /* First draw decodes into the cache, the second is served from it. */
+    for (int pass = 0; pass < 2; pass++) {
+        clear_surface();
+        EXPECT_GT(draw(handle, "12:34"), 0);
+        expect_rendered(font, "12:34");
+    }
+
+    qp_close_font(handle);
+}
+
+TEST_F(GlyphCache, ColorsAreCachedSeparately) {
+    TestFont              font(1);
+    painter_font_handle_t handle = qp_load_font_mem(font.data.data());
+    ASSERT_NE(handle, nullptr);
+
+    for (int pass = 0; pass < 2; pass++) {
+        clear_surface();
+        draw(handle, "WPM");
+        expect_rendered(font, "WPM");
+
+        clear_surface();
+        draw(handle, "WPM", true);
+        expect_rendered(font, "WPM", true);
+    }
+
+    qp_close_font(handle);
+}
+
+TEST_F(GlyphCache, EvictsWhenFull) {
+    TestFont              font(2);
+    painter_font_handle_t handle = qp_load_font_mem(font.data.data());
+    ASSERT_NE(handle, nullptr);
+
+    /* More glyphs than fit in the arena or the entry table, redrawn in varying orders. */
+    const char *strings[] = {"0123456789", "ABCDEFGHIJ", "9876543210", "0A1B2C3D4E", "abcdefghij"};
+    for (int pass = 0; pass < 3; pass++) {
+        for (const char *str : strings) {
+            clear_surface();
+            draw(handle, str);
+            expect_rendered(font, str);
+        }
+    }
+
+    qp_close_font(handle);
+}
+
+TEST_F(GlyphCache, ClosingFontInvalidatesItsGlyphs) {
+    TestFont              first(3);
+    TestFont              second(4);
+    painter_font_handle_t handle = qp_load_font_mem(first.data.data());
+    ASSERT_NE(handle, nullptr);
+    clear_surface();
+    draw(handle, "88");
+    expect_rendered(first, "88");
+    qp_close_font(handle);
+
+    /* The new font reuses the same handle. */
+    painter_font_handle_t reloaded = qp_load_font_mem(second.data.data());
+    ASSERT_EQ(reloaded, handle);
+    clear_surface();
+    draw(reloaded, "88");
+    expect_rendered(second, "88");
+    qp_close_font(reloaded);
+}
+
+/* Counts the work the surface is asked to do, forwarding to its own driver. */
+static const painter_driver_vtable_t *surface_vtable;
+static painter_driver_vtable_t        counting_vtable;
+static uint32_t                       append_pixels_calls;
+static uint32_t                       pixdata_calls;
+
+static bool counting_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    append_pixels_calls++;
+    return surface_vtable->append_pixels(device, target_buffer, palette, pixel_offset, pixel_count, palette_indices);
+}
+
+static bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    pixdata_calls++;
+    return surface_vtable->pixdata(device, pixel_data, native_pixel_count);
+}
+
+TEST_F(GlyphCache, RedrawSkipsDecoding) {
+    TestFont              font(5);
+    painter_font_handle_t handle = qp_load_font_mem(font.data.data());
+    painter_driver_t     *driver = (painter_driver_t *)surface;
+    ASSERT_NE(handle, nullptr);
+
+    surface_vtable                = driver->driver_vtable;
+    counting_vtable               = *surface_vtable;
+    counting_vtable.append_pixels = counting_append_pixels;
+    counting_vtable.pixdata       = counting_pixdata;
+    driver->driver_vtable         = &counting_vtable;
+
+    /* Each glyph is decoded once, the second ':' is already cached by the time it is drawn. */
+    const char *str    = "12:34:56";
+    uint32_t    pixels = 0;
+    for (const char *c = str; *c; c++) {
+        if (strchr(str, *c) == c) {
+            pixels += TestFont::width(*c) * GLYPH_HEIGHT;
+        }
+    }
+
+    append_pixels_calls = 0;
+    pixdata_calls       = 0;
+    clear_surface();
+    draw(handle, str);
+    expect_rendered(font, str);
+    EXPECT_EQ(append_pixels_calls, pixels);
+    EXPECT_EQ(pixdata_calls, strlen(str));
+
+    /* Redrawing sends each cached glyph in one go, without decoding anything. */
+    append_pixels_calls = 0;
+    pixdata_calls       = 0;
+    clear_surface();
+    draw(handle, str);
+    expect_rendered(font, str);
+    EXPECT_EQ(append_pixels_calls, 0);
+    EXPECT_EQ(pixdata_calls, strlen(str));
+
+    driver->driver_vtable = surface_vtable;
+    qp_close_font(handle);
+}
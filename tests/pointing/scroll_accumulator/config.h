@@ -0,0 +1,13 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 12
+#define POINTING_DEVICE_SCROLL_ACCUMULATOR_ENABLE
+#define POINTING_DEVICE_SCROLL_DIVISOR 8
+#define POINTING_DEVICE_SCROLL_ACCELERATION 25
+#define POINTING_DEVICE_SCROLL_ACCELERATION_MAX 200
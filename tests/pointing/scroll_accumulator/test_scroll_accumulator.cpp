@@ -0,0 +1,172 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+class ScrollAccumulator : public TestFixture {
+   protected:
+    void SetUp() override {
+        TestFixture::SetUp();
+        pointing_device_scroll_clear();
+    }
+};
+
+TEST_F(ScrollAccumulator, DetentIsOneHiresNotch) {
+    TestDriver driver;
+
+    ASSERT_EQ(pointing_device_get_hires_scroll_resolution(), 12);
+
+    pointing_device_scroll_add_detents(0, 1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 12, 0));
+    run_one_scan_loop();
+
+    pointing_device_scroll_add_detents(-1, 0);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, -12, 0, 0));
+    run_one_scan_loop();
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, DetentsAreBatchedAndAccelerated) {
+    TestDriver driver;
+
+    // 4 detents within one report scroll 175% as far
+    for (int i = 0; i < 4; i++) {
+        pointing_device_scroll_add_detents(0, -1);
+    }
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -84, 0));
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, OverflowCarriesToNextReport) {
+    TestDriver driver;
+
+    // Acceleration is capped at 200%
+    pointing_device_scroll_add_detents(0, 10);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 127, 0));
+    run_one_scan_loop();
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 113, 0));
+    run_one_scan_loop();
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, MotionKeepsFractions) {
+    TestDriver driver;
+
+    // Each count is 12 / 8 of a hires unit
+    pointing_device_scroll_add_motion(0, 1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    pointing_device_scroll_add_motion(0, 1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 2, 0));
+    run_one_scan_loop();
+    pointing_device_scroll_add_motion(0, 1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+
+    // Turning back doesn't have to make up for the half unit left over
+    pointing_device_scroll_add_motion(0, -1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -1, 0));
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, MotionAndDetentsShareOneReport) {
+    TestDriver driver;
+
+    pointing_device_scroll_add_motion(4, 0);
+    pointing_device_scroll_add_detents(0, 1);
+    pd_set_x(5);
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 6, 12, 0));
+    run_one_scan_loop();
+
+    pd_clear_movement();
+    run_one_scan_loop();
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, CarryIsCapped) {
+    TestDriver driver;
+
+    // 100 detents at 200% is far more than fits in the carry, only the cap is sent after the first report
+    pointing_device_scroll_add_detents(0, 100);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 127, 0)).Times(1 + POINTING_DEVICE_SCROLL_CARRY_MAX);
+    for (int i = 0; i < 1 + POINTING_DEVICE_SCROLL_CARRY_MAX; i++) {
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, ScrollsWhileSensorFails) {
+    TestDriver driver;
+
+    pointing_device_set_status(POINTING_DEVICE_STATUS_FAILED);
+    pointing_device_scroll_add_detents(0, 1);
+    pd_set_x(5);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 12, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing was left to build up while the sensor was out
+    pointing_device_set_status(POINTING_DEVICE_STATUS_SUCCESS);
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, 0, 0));
+    run_one_scan_loop();
+    pd_clear_movement();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScrollAccumulator, EncoderWheelKeycodesScroll) {
+    TestDriver driver;
+    KeymapKey  wheel_key = KeymapKey(0, 0, 0, QK_MOUSE_WHEEL_DOWN);
+
+    // Encoder 0 clockwise, as the encoder map would look it up
+    add_key(KeymapKey(0, 0, KEYLOC_ENCODER_CW, QK_MOUSE_WHEEL_DOWN));
+    add_key(wheel_key);
+
+    // Two detents in one poll are batched into one accelerated report
+    keyevent_t event;
+    event.key  = {.col = 0, .row = KEYLOC_ENCODER_CW};
+    event.type = ENCODER_CW_EVENT;
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -30, 0));
+    for (int i = 0; i < 2; i++) {
+        event.pressed = true;
+        event.time    = timer_read();
+        action_exec(event);
+        event.pressed = false;
+        event.time    = timer_read();
+        action_exec(event);
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Only encoders are batched, wheel keys on the matrix are left alone
+    wheel_key.press();
+    run_one_scan_loop();
+    wheel_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,136 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void advance_time(uint32_t ms);
+}
+
+#define RENDER_FRAMES 1000
+
+/* FNV-1a hash of every colour written by the driver, so that rendering can be checked against the original runners. */
+static uint32_t frame_hash = 2166136261u;
+static uint32_t flushes    = 0;
+
+static void hash_byte(uint8_t byte) {
+    frame_hash = (frame_hash ^ byte) * 16777619u;
+}
+
+extern "C" {
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    hash_byte(index);
+    hash_byte(r);
+    hash_byte(g);
+    hash_byte(b);
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void test_flush(void) {
+    flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_init,
+    .set_color     = test_set_color,
+    .set_color_all = test_set_color_all,
+    .flush         = test_flush,
+};
+
+/* 4x10 grid spanning the whole LED coordinate space. */
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {
+        {0, 0}, {24, 0}, {49, 0}, {74, 0}, {99, 0}, {124, 0}, {149, 0}, {174, 0}, {199, 0}, {224, 0},
+        {0, 21}, {24, 21}, {49, 21}, {74, 21}, {99, 21}, {124, 21}, {149, 21}, {174, 21}, {199, 21}, {224, 21},
+        {0, 42}, {24, 42}, {49, 42}, {74, 42}, {99, 42}, {124, 42}, {149, 42}, {174, 42}, {199, 42}, {224, 42},
+        {0, 64}, {24, 64}, {49, 64}, {74, 64}, {99, 64}, {124, 64}, {149, 64}, {174, 64}, {199, 64}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    },
+};
+}
+
+struct PolarEffect {
+    const char* name;
+    uint8_t     mode;
+    uint32_t    hash; // rendered by the original dx/dy runners
+};
+
+class PolarCache : public TestFixture, public testing::WithParamInterface<PolarEffect> {
+   protected:
+    /* Renders one full frame. */
+    static void render_frame() {
+        uint32_t start = flushes;
+
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int i = 0; i < 2 * RGB_MATRIX_LED_COUNT && flushes == start; i++) {
+            rgb_matrix_task();
+        }
+        EXPECT_GT(flushes, start) << "frame did not complete";
+    }
+};
+
+TEST_P(PolarCache, RendersSameFrames) {
+    TestDriver driver;
+
+    rgb_matrix_mode_noeeprom(GetParam().mode);
+    render_frame();
+
+    frame_hash = 2166136261u;
+    for (int frame = 0; frame < RENDER_FRAMES; frame++) {
+        render_frame();
+    }
+
+    EXPECT_EQ(frame_hash, GetParam().hash) << "rendered frames differ";
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Effects,
+    PolarCache,
+    testing::Values(
+        PolarEffect{"BAND_PINWHEEL_SAT", RGB_MATRIX_BAND_PINWHEEL_SAT, 0xA8F0CB43u},
+        PolarEffect{"BAND_PINWHEEL_VAL", RGB_MATRIX_BAND_PINWHEEL_VAL, 0x116182CEu},
+        PolarEffect{"BAND_SPIRAL_SAT",   RGB_MATRIX_BAND_SPIRAL_SAT,   0xB5F63BEDu},
+        PolarEffect{"BAND_SPIRAL_VAL",   RGB_MATRIX_BAND_SPIRAL_VAL,   0x90C5EA29u},
+        PolarEffect{"CYCLE_OUT_IN",      RGB_MATRIX_CYCLE_OUT_IN,      0x311CE09Du},
+        PolarEffect{"CYCLE_PINWHEEL",    RGB_MATRIX_CYCLE_PINWHEEL,    0x06E661ABu},
+        PolarEffect{"CYCLE_SPIRAL",      RGB_MATRIX_CYCLE_SPIRAL,      0x8600BB2Fu}
+    ),
+    [](const testing::TestParamInfo<PolarEffect>& info) { return std::string(info.param.name); });
+// clang-format on
+
+class PolarCacheUpdate : public TestFixture {};
+
+TEST_F(PolarCacheUpdate, FollowsLedConfig) {
+    TestDriver  driver;
+    led_point_t saved = g_led_config.point[0];
+
+    EXPECT_EQ(g_rgb_matrix_polar[0].angle, 143) << "top left is to the left of and above the center";
+
+    g_led_config.point[0] = {112 + 30, 32 + 40};
+    rgb_matrix_update_polar_cache();
+    EXPECT_EQ(g_rgb_matrix_polar[0].dist, 50);
+    EXPECT_EQ(g_rgb_matrix_polar[0].angle, 36);
+
+    g_led_config.point[0] = saved;
+    rgb_matrix_update_polar_cache();
+
+    VERIFY_AND_CLEAR(driver);
+}
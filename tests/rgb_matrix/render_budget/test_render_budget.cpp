@@ -0,0 +1,154 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+/* Fake microsecond clock, advanced by the driver every time an LED is written. */
+static uint32_t fake_us     = 0;
+static uint32_t led_cost_us = 0;
+static uint8_t  leds_set    = 0;
+static uint32_t flushes     = 0;
+
+extern "C" {
+uint32_t rgb_matrix_render_timer_us(void) {
+    return fake_us;
+}
+
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    fake_us += led_cost_us;
+    leds_set++;
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void test_flush(void) {
+    flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_init,
+    .set_color     = test_set_color,
+    .set_color_all = test_set_color_all,
+    .flush         = test_flush,
+};
+
+led_config_t g_led_config;
+}
+
+class RenderBudget : public TestFixture {
+   protected:
+    void SetUp() override {
+        memset(g_led_config.matrix_co, NO_LED, sizeof(g_led_config.matrix_co));
+        memset(g_led_config.flags, LED_FLAG_KEYLIGHT, sizeof(g_led_config.flags));
+        TestFixture::SetUp();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        rgb_matrix_reset_render_stats();
+    }
+
+    /* Renders one full frame, returning how many LEDs each render iteration covered. */
+    std::vector<uint8_t> render_frame() {
+        std::vector<uint8_t> chunks;
+        uint32_t             start = flushes;
+
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int i = 0; i < 2 * RGB_MATRIX_LED_COUNT && flushes == start; i++) {
+            leds_set = 0;
+            rgb_matrix_task();
+            if (leds_set > 0) {
+                chunks.push_back(leds_set);
+            }
+        }
+        EXPECT_GT(flushes, start) << "frame did not complete";
+        return chunks;
+    }
+};
+
+TEST_F(RenderBudget, ExpensiveEffectIsSplitToFitBudget) {
+    TestDriver driver;
+
+    led_cost_us = 10;
+    for (int i = 0; i < 10; i++) {
+        render_frame();
+    }
+
+    auto chunks = render_frame();
+    int  total  = 0;
+    for (uint8_t chunk : chunks) {
+        EXPECT_LE(chunk * led_cost_us, RGB_MATRIX_RENDER_BUDGET_US);
+        total += chunk;
+    }
+    EXPECT_EQ(total, RGB_MATRIX_LED_COUNT);
+    EXPECT_EQ(chunks.size(), RGB_MATRIX_LED_COUNT * led_cost_us / RGB_MATRIX_RENDER_BUDGET_US);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(RenderBudget, CheapEffectRendersInOneIteration) {
+    TestDriver driver;
+
+    led_cost_us = 1;
+    for (int i = 0; i < 10; i++) {
+        render_frame();
+    }
+
+    auto chunks = render_frame();
+    ASSERT_EQ(chunks.size(), 1);
+    EXPECT_EQ(chunks[0], RGB_MATRIX_LED_COUNT);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(RenderBudget, AdaptsWhenCostChanges) {
+    TestDriver driver;
+
+    led_cost_us = 1;
+    for (int i = 0; i < 3; i++) {
+        render_frame();
+    }
+
+    /* The effect gets expensive, iterations must shrink back within a few frames. */
+    led_cost_us = 20;
+    for (int i = 0; i < 10; i++) {
+        render_frame();
+    }
+    for (uint8_t chunk : render_frame()) {
+        EXPECT_LE(chunk * led_cost_us, RGB_MATRIX_RENDER_BUDGET_US);
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(RenderBudget, ReportsFramesPerSecondAndRenderCost) {
+    TestDriver                driver;
+    rgb_matrix_render_stats_t stats;
+
+    led_cost_us = 5;
+    for (int i = 0; i < 2 * 1000 / RGB_MATRIX_LED_FLUSH_LIMIT; i++) {
+        render_frame();
+    }
+
+    EXPECT_GE(rgb_matrix_get_fps(), 50);
+    EXPECT_LE(rgb_matrix_get_fps(), 1000 / RGB_MATRIX_LED_FLUSH_LIMIT);
+
+    ASSERT_TRUE(rgb_matrix_get_render_stats(RGB_MATRIX_SOLID_COLOR, &stats));
+    EXPECT_GE(stats.frames, 2 * 1000 / RGB_MATRIX_LED_FLUSH_LIMIT);
+    EXPECT_EQ(stats.avg_render_us, RGB_MATRIX_LED_COUNT * led_cost_us);
+
+    ASSERT_TRUE(rgb_matrix_get_render_stats(RGB_MATRIX_NONE, &stats));
+    EXPECT_EQ(stats.frames, 0);
+    EXPECT_FALSE(rgb_matrix_get_render_stats(RGB_MATRIX_EFFECT_MAX, &stats));
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,135 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void advance_time(uint32_t ms);
+}
+
+#define TYPING_FRAMES 480
+#define TYPING_INTERVAL 12
+#define IDLE_FRAMES 1500
+
+/* FNV-1a hash of every colour written by the driver, so that rendering can be checked against the original runners. */
+static uint32_t frame_hash = 2166136261u;
+static uint32_t flushes    = 0;
+
+static void hash_byte(uint8_t byte) {
+    frame_hash = (frame_hash ^ byte) * 16777619u;
+}
+
+extern "C" {
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    hash_byte(index);
+    hash_byte(r);
+    hash_byte(g);
+    hash_byte(b);
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void test_flush(void) {
+    flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_init,
+    .set_color     = test_set_color,
+    .set_color_all = test_set_color_all,
+    .flush         = test_flush,
+};
+
+/* 4x10 grid spanning the whole LED coordinate space. */
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {
+        {0, 0}, {24, 0}, {49, 0}, {74, 0}, {99, 0}, {124, 0}, {149, 0}, {174, 0}, {199, 0}, {224, 0},
+        {0, 21}, {24, 21}, {49, 21}, {74, 21}, {99, 21}, {124, 21}, {149, 21}, {174, 21}, {199, 21}, {224, 21},
+        {0, 42}, {24, 42}, {49, 42}, {74, 42}, {99, 42}, {124, 42}, {149, 42}, {174, 42}, {199, 42}, {224, 42},
+        {0, 64}, {24, 64}, {49, 64}, {74, 64}, {99, 64}, {124, 64}, {149, 64}, {174, 64}, {199, 64}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    },
+};
+}
+
+struct ReactiveEffect {
+    const char* name;
+    uint8_t     mode;
+    uint32_t    hash; // rendered by the original runners
+};
+
+class SparseReactive : public TestFixture, public testing::WithParamInterface<ReactiveEffect> {
+   protected:
+    void SetUp() override {
+        rgb_matrix_init();
+        rgb_matrix_mode_noeeprom(GetParam().mode);
+        render_frame();
+        frame_hash = 2166136261u;
+    }
+
+    /* Renders one full frame. */
+    static void render_frame() {
+        uint32_t start = flushes;
+
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int i = 0; i < 2 * RGB_MATRIX_LED_COUNT && flushes == start; i++) {
+            rgb_matrix_task();
+        }
+        EXPECT_GT(flushes, start) << "frame did not complete";
+    }
+};
+
+/* A burst of typing, followed by a long idle period during which the hits are still remembered. */
+TEST_P(SparseReactive, RendersSameFrames) {
+    TestDriver driver;
+
+    for (int frame = 0; frame < TYPING_FRAMES; frame++) {
+        if (frame % TYPING_INTERVAL == 0) {
+            uint8_t led = (frame / TYPING_INTERVAL * 17 + 3) % RGB_MATRIX_LED_COUNT;
+            rgb_matrix_handle_key_event(led / MATRIX_COLS, led % MATRIX_COLS, true);
+        }
+        render_frame();
+    }
+    for (int frame = 0; frame < IDLE_FRAMES; frame++) {
+        render_frame();
+    }
+
+    EXPECT_EQ(frame_hash, GetParam().hash) << "rendered frames differ";
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Effects,
+    SparseReactive,
+    testing::Values(
+        ReactiveEffect{"SOLID_REACTIVE_SIMPLE",     RGB_MATRIX_SOLID_REACTIVE_SIMPLE,     0x90E8132Du},
+        ReactiveEffect{"SOLID_REACTIVE",            RGB_MATRIX_SOLID_REACTIVE,            0xB5AD46ADu},
+        ReactiveEffect{"SOLID_REACTIVE_WIDE",       RGB_MATRIX_SOLID_REACTIVE_WIDE,       0x787E9931u},
+        ReactiveEffect{"SOLID_REACTIVE_MULTIWIDE",  RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE,  0xF43101A9u},
+        ReactiveEffect{"SOLID_REACTIVE_CROSS",      RGB_MATRIX_SOLID_REACTIVE_CROSS,      0xD45BC3ABu},
+        ReactiveEffect{"SOLID_REACTIVE_MULTICROSS", RGB_MATRIX_SOLID_REACTIVE_MULTICROSS, 0x9CE6D987u},
+        ReactiveEffect{"SOLID_REACTIVE_NEXUS",      RGB_MATRIX_SOLID_REACTIVE_NEXUS,      0xB7993162u},
+        ReactiveEffect{"SOLID_REACTIVE_MULTINEXUS", RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS, 0x5033BFD6u},
+        ReactiveEffect{"SPLASH",                    RGB_MATRIX_SPLASH,                    0x7F96B428u},
+        ReactiveEffect{"MULTISPLASH",               RGB_MATRIX_MULTISPLASH,               0x2E7586FAu},
+        ReactiveEffect{"SOLID_SPLASH",              RGB_MATRIX_SOLID_SPLASH,              0x5E3E8AD4u},
+        ReactiveEffect{"SOLID_MULTISPLASH",         RGB_MATRIX_SOLID_MULTISPLASH,         0xD3FC8B36u}
+    ),
+    [](const testing::TestParamInfo<ReactiveEffect>& info) { return std::string(info.param.name); });
+// clang-format on
@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../splash_distance_render.hpp"
+
+TEST_F(SplashDistance, RenderWithSqrt) {
+    TestDriver driver;
+
+    render_frames();
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,61 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// 4x10 grid spanning the whole LED coordinate space, as generated by `qmk generate-keyboard-c`
+#ifdef RGB_MATRIX_ENABLE
+#include "rgb_matrix.h"
+__attribute__ ((weak)) led_config_t g_led_config = {
+  {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 },
+    { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 },
+    { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 },
+    { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39 },
+  },
+  { {0, 0}, {24, 0}, {49, 0}, {74, 0}, {99, 0}, {124, 0}, {149, 0}, {174, 0}, {199, 0}, {224, 0}, {0, 21}, {24, 21}, {49, 21}, {74, 21}, {99, 21}, {124, 21}, {149, 21}, {174, 21}, {199, 21}, {224, 21}, {0, 42}, {24, 42}, {49, 42}, {74, 42}, {99, 42}, {124, 42}, {149, 42}, {174, 42}, {199, 42}, {224, 42}, {0, 64}, {24, 64}, {49, 64}, {74, 64}, {99, 64}, {124, 64}, {149, 64}, {174, 64}, {199, 64}, {224, 64} },
+  { 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4 },
+};
+#ifdef RGB_MATRIX_SPLASH_DISTANCE_TABLE
+#include "progmem.h"
+__attribute__ ((weak)) const uint8_t g_rgb_matrix_splash_distance[] PROGMEM = {
+    24,
+    49, 25,
+    74, 50, 25,
+    99, 75, 50, 25,
+    124, 100, 75, 50, 25,
+    149, 125, 100, 75, 50, 25,
+    174, 150, 125, 100, 75, 50, 25,
+    199, 175, 150, 125, 100, 75, 50, 25,
+    224, 200, 175, 150, 125, 100, 75, 50, 25,
+    21, 31, 53, 76, 101, 125, 150, 175, 200, 224,
+    31, 21, 32, 54, 77, 102, 126, 151, 176, 201, 24,
+    53, 32, 21, 32, 54, 77, 102, 126, 151, 176, 49, 25,
+    76, 54, 32, 21, 32, 54, 77, 102, 126, 151, 74, 50, 25,
+    101, 77, 54, 32, 21, 32, 54, 77, 102, 126, 99, 75, 50, 25,
+    125, 102, 77, 54, 32, 21, 32, 54, 77, 102, 124, 100, 75, 50, 25,
+    150, 126, 102, 77, 54, 32, 21, 32, 54, 77, 149, 125, 100, 75, 50, 25,
+    175, 151, 126, 102, 77, 54, 32, 21, 32, 54, 174, 150, 125, 100, 75, 50, 25,
+    200, 176, 151, 126, 102, 77, 54, 32, 21, 32, 199, 175, 150, 125, 100, 75, 50, 25,
+    224, 201, 176, 151, 126, 102, 77, 54, 32, 21, 224, 200, 175, 150, 125, 100, 75, 50, 25,
+    42, 48, 64, 85, 107, 130, 154, 178, 203, 227, 21, 31, 53, 76, 101, 125, 150, 175, 200, 224,
+    48, 42, 48, 65, 85, 108, 131, 155, 179, 204, 31, 21, 32, 54, 77, 102, 126, 151, 176, 201, 24,
+    64, 48, 42, 48, 65, 85, 108, 131, 155, 179, 53, 32, 21, 32, 54, 77, 102, 126, 151, 176, 49, 25,
+    85, 65, 48, 42, 48, 65, 85, 108, 131, 155, 76, 54, 32, 21, 32, 54, 77, 102, 126, 151, 74, 50, 25,
+    107, 85, 65, 48, 42, 48, 65, 85, 108, 131, 101, 77, 54, 32, 21, 32, 54, 77, 102, 126, 99, 75, 50, 25,
+    130, 108, 85, 65, 48, 42, 48, 65, 85, 108, 125, 102, 77, 54, 32, 21, 32, 54, 77, 102, 124, 100, 75, 50, 25,
+    154, 131, 108, 85, 65, 48, 42, 48, 65, 85, 150, 126, 102, 77, 54, 32, 21, 32, 54, 77, 149, 125, 100, 75, 50, 25,
+    178, 155, 131, 108, 85, 65, 48, 42, 48, 65, 175, 151, 126, 102, 77, 54, 32, 21, 32, 54, 174, 150, 125, 100, 75, 50, 25,
+    203, 179, 155, 131, 108, 85, 65, 48, 42, 48, 200, 176, 151, 126, 102, 77, 54, 32, 21, 32, 199, 175, 150, 125, 100, 75, 50, 25,
+    227, 204, 179, 155, 131, 108, 85, 65, 48, 42, 224, 201, 176, 151, 126, 102, 77, 54, 32, 21, 224, 200, 175, 150, 125, 100, 75, 50, 25,
+    64, 68, 80, 97, 117, 139, 162, 185, 209, 232, 43, 49, 65, 85, 107, 131, 155, 179, 203, 228, 22, 32, 53, 77, 101, 125, 150, 175, 200, 225,
+    68, 64, 68, 81, 98, 118, 140, 163, 186, 209, 49, 43, 49, 65, 86, 108, 132, 156, 180, 204, 32, 22, 33, 54, 78, 102, 126, 151, 176, 201, 24,
+    80, 68, 64, 68, 81, 98, 118, 140, 163, 186, 65, 49, 43, 49, 65, 86, 108, 132, 156, 180, 53, 33, 22, 33, 54, 78, 102, 126, 151, 176, 49, 25,
+    97, 81, 68, 64, 68, 81, 98, 118, 140, 163, 85, 65, 49, 43, 49, 65, 86, 108, 132, 156, 77, 54, 33, 22, 33, 54, 78, 102, 126, 151, 74, 50, 25,
+    117, 98, 81, 68, 64, 68, 81, 98, 118, 140, 107, 86, 65, 49, 43, 49, 65, 86, 108, 132, 101, 78, 54, 33, 22, 33, 54, 78, 102, 126, 99, 75, 50, 25,
+    139, 118, 98, 81, 68, 64, 68, 81, 98, 118, 131, 108, 86, 65, 49, 43, 49, 65, 86, 108, 125, 102, 78, 54, 33, 22, 33, 54, 78, 102, 124, 100, 75, 50, 25,
+    162, 140, 118, 98, 81, 68, 64, 68, 81, 98, 155, 132, 108, 86, 65, 49, 43, 49, 65, 86, 150, 126, 102, 78, 54, 33, 22, 33, 54, 78, 149, 125, 100, 75, 50, 25,
+    185, 163, 140, 118, 98, 81, 68, 64, 68, 81, 179, 156, 132, 108, 86, 65, 49, 43, 49, 65, 175, 151, 126, 102, 78, 54, 33, 22, 33, 54, 174, 150, 125, 100, 75, 50, 25,
+    209, 186, 163, 140, 118, 98, 81, 68, 64, 68, 203, 180, 156, 132, 108, 86, 65, 49, 43, 49, 200, 176, 151, 126, 102, 78, 54, 33, 22, 33, 199, 175, 150, 125, 100, 75, 50, 25,
+    232, 209, 186, 163, 140, 118, 98, 81, 68, 64, 228, 204, 180, 156, 132, 108, 86, 65, 49, 43, 225, 201, 176, 151, 126, 102, 78, 54, 33, 22, 224, 200, 175, 150, 125, 100, 75, 50, 25,
+};
+#endif
+#endif
@@ -0,0 +1,93 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+
+void advance_time(uint32_t ms);
+}
+
+#define RENDER_FRAMES 2000
+
+/* Hash of every colour written while rendering, identical with and without the distance table. */
+#define RENDER_FRAME_HASH 0x0253EE80u
+
+/* FNV-1a hash of every colour written by the driver, so that both builds can be checked for identical output. */
+static uint32_t frame_hash = 2166136261u;
+static uint32_t flushes    = 0;
+
+static void hash_byte(uint8_t byte) {
+    frame_hash = (frame_hash ^ byte) * 16777619u;
+}
+
+extern "C" {
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    hash_byte(index);
+    hash_byte(r);
+    hash_byte(g);
+    hash_byte(b);
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+static void test_flush(void) {
+    flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_init,
+    .set_color     = test_set_color,
+    .set_color_all = test_set_color_all,
+    .flush         = test_flush,
+};
+}
+
+class SplashDistance : public TestFixture {
+   protected:
+    void SetUp() override {
+        TestFixture::SetUp();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_MULTISPLASH);
+
+        /* Catch the hit timers up with however long earlier tests ran for. */
+        render_frame();
+        frame_hash = 2166136261u;
+    }
+
+    /* Hits LED_HITS_TO_REMEMBER keys scattered over the grid. */
+    static void hit_keys() {
+        for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; i++) {
+            uint8_t led = (i * 17 + 3) % RGB_MATRIX_LED_COUNT;
+            rgb_matrix_handle_key_event(led / MATRIX_COLS, led % MATRIX_COLS, true);
+        }
+    }
+
+    /* Renders one full frame. */
+    static void render_frame() {
+        uint32_t start = flushes;
+
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (int i = 0; i < 2 * RGB_MATRIX_LED_COUNT && flushes == start; i++) {
+            rgb_matrix_task();
+        }
+        EXPECT_GT(flushes, start) << "frame did not complete";
+    }
+
+    /* Renders RENDER_FRAMES full frames, hitting the keys again every so often, and checks what was drawn. */
+    static void render_frames() {
+        for (int frame = 0; frame < RENDER_FRAMES; frame++) {
+            if (frame % 64 == 0) {
+                hit_keys();
+            }
+            render_frame();
+        }
+
+        EXPECT_EQ(frame_hash, RENDER_FRAME_HASH) << "rendered frames differ";
+    }
+};
@@ -0,0 +1,36 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "splash_distance_render.hpp"
+
+/* Reference floor square root, truncated to 16 bits like the runner's sqrt16(dx * dx + dy * dy). */
+static uint8_t reference_distance(int16_t dx, int16_t dy) {
+    uint16_t x = dx * dx + dy * dy;
+    uint8_t  r = 0;
+    while ((r + 1) * (r + 1) <= x && r < 255) {
+        r++;
+    }
+    return r;
+}
+
+TEST_F(SplashDistance, TableMatchesPoints) {
+    TestDriver driver;
+
+    for (uint8_t a = 1; a < RGB_MATRIX_LED_COUNT; a++) {
+        for (uint8_t b = 0; b < a; b++) {
+            int16_t dx = g_led_config.point[a].x - g_led_config.point[b].x;
+            int16_t dy = g_led_config.point[a].y - g_led_config.point[b].y;
+            EXPECT_EQ(g_rgb_matrix_splash_distance[a * (a - 1) / 2 + b], reference_distance(dx, dy)) << "LEDs " << (int)a << " and " << (int)b;
+        }
+    }
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplashDistance, RenderWithTable) {
+    TestDriver driver;
+
+    render_frames();
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Results are inspected directly rather than printed periodically
+#define SCAN_PROFILER_REPORT_INTERVAL 0
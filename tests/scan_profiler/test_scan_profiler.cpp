@@ -0,0 +1,167 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "scan_profiler.h"
+}
+
+using testing::_;
+
+static uint32_t fake_cycles = 0;
+
+extern "C" {
+uint32_t scan_profiler_read_cycles(void) {
+    return fake_cycles;
+}
+
+void housekeeping_task_user(void) {
+    fake_cycles += 100;
+}
+
+bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed) {
+        fake_cycles += 5000;
+    }
+    return true;
+}
+}
+
+class ScanProfiler : public TestFixture {
+   public:
+    ScanProfiler() {
+        scan_profiler_reset();
+    }
+
+    scan_profiler_summary_t summary(scan_profiler_stage_t stage) {
+        scan_profiler_summary_t summary;
+        EXPECT_TRUE(scan_profiler_get_summary(stage, &summary));
+        return summary;
+    }
+};
+
+TEST_F(ScanProfiler, HousekeepingStage) {
+    TestDriver driver;
+
+    idle_for(100);
+
+    auto housekeeping = summary(SCAN_PROFILER_STAGE_HOUSEKEEPING);
+    EXPECT_EQ(housekeeping.count, 100);
+    EXPECT_EQ(housekeeping.min, 100);
+    EXPECT_EQ(housekeeping.avg, 100);
+    EXPECT_EQ(housekeeping.max, 100);
+    EXPECT_EQ(housekeeping.p99, 100);
+
+    auto matrix = summary(SCAN_PROFILER_STAGE_MATRIX);
+    EXPECT_EQ(matrix.count, 100);
+    EXPECT_EQ(matrix.max, 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanProfiler, SlowKeyPressShowsInMaxButNotP99) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    idle_for(199);
+    VERIFY_AND_CLEAR(driver);
+
+    auto matrix = summary(SCAN_PROFILER_STAGE_MATRIX);
+    EXPECT_EQ(matrix.count, 200);
+    EXPECT_EQ(matrix.min, 0);
+    EXPECT_EQ(matrix.avg, 25);
+    EXPECT_EQ(matrix.max, 5000);
+    EXPECT_EQ(matrix.p99, 0);
+
+    auto keyboard_task = summary(SCAN_PROFILER_STAGE_KEYBOARD_TASK);
+    EXPECT_EQ(keyboard_task.count, 200);
+    EXPECT_EQ(keyboard_task.max, 5000);
+
+    /* Nothing was measured for stages of disabled features */
+    EXPECT_EQ(summary(SCAN_PROFILER_STAGE_RGB_MATRIX).count, 0);
+}
+
+TEST_F(ScanProfiler, PercentileFromHistogram) {
+    TestDriver driver;
+
+    for (int i = 0; i < 90; i++) {
+        scan_profiler_record(SCAN_PROFILER_STAGE_OLED, 10);
+    }
+    for (int i = 0; i < 10; i++) {
+        scan_profiler_record(SCAN_PROFILER_STAGE_OLED, 1000);
+    }
+
+    auto oled = summary(SCAN_PROFILER_STAGE_OLED);
+    EXPECT_EQ(oled.count, 100);
+    EXPECT_EQ(oled.min, 10);
+    EXPECT_EQ(oled.avg, 109);
+    EXPECT_EQ(oled.max, 1000);
+    /* p99 is the upper bound of the log2 bucket holding it, capped to the maximum */
+    EXPECT_EQ(oled.p99, 1000);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanProfiler, HistogramSurvivesSaturation) {
+    TestDriver driver;
+
+    for (int i = 0; i < 100000; i++) {
+        scan_profiler_record(SCAN_PROFILER_STAGE_ENCODER, 20);
+    }
+    scan_profiler_record(SCAN_PROFILER_STAGE_ENCODER, 4000);
+
+    auto encoder = summary(SCAN_PROFILER_STAGE_ENCODER);
+    EXPECT_EQ(encoder.count, 100001);
+    EXPECT_EQ(encoder.max, 4000);
+    EXPECT_EQ(encoder.p99, 31);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanProfiler, RawHidQuery) {
+    TestDriver driver;
+    uint8_t    data[32] = {0};
+
+    for (int i = 0; i < 3; i++) {
+        scan_profiler_record(SCAN_PROFILER_STAGE_POINTING_DEVICE, 0x01020304);
+    }
+
+    data[0] = SCAN_PROFILER_RAW_HID_ID;
+    data[1] = SCAN_PROFILER_STAGE_POINTING_DEVICE;
+    data[2] = 0x01; // reset after reading
+    EXPECT_TRUE(scan_profiler_raw_hid_command(data, sizeof(data)));
+
+    EXPECT_EQ(data[2], 0);
+    EXPECT_EQ(data[3], 3);
+    EXPECT_EQ(data[4], 0);
+    for (int value = 0; value < 4; value++) {
+        /* min, avg, max and p99 are all identical */
+        EXPECT_EQ(data[7 + value * 4], 0x04);
+        EXPECT_EQ(data[8 + value * 4], 0x03);
+        EXPECT_EQ(data[9 + value * 4], 0x02);
+        EXPECT_EQ(data[10 + value * 4], 0x01);
+    }
+    EXPECT_EQ(summary(SCAN_PROFILER_STAGE_POINTING_DEVICE).count, 0);
+
+    data[0] = SCAN_PROFILER_RAW_HID_ID;
+    data[1] = SCAN_PROFILER_STAGE_COUNT;
+    EXPECT_TRUE(scan_profiler_raw_hid_command(data, sizeof(data)));
+    EXPECT_EQ(data[2], 1);
+
+    data[0] = 0x01;
+    EXPECT_FALSE(scan_profiler_raw_hid_command(data, sizeof(data)));
+
+    VERIFY_AND_CLEAR(driver);
+}
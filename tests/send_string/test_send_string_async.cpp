@@ -0,0 +1,259 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "send_string.h"
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        // Also restarts the executor, as the timer is reset between tests
+        send_string_async_cancel();
+    }
+
+    void TearDown() override {
+        send_string_async_cancel();
+        TestFixture::TearDown();
+    }
+};
+
+typedef struct {
+    const char *string;
+    unsigned    reads;
+} counting_state_t;
+
+static char counting_getter(void *arg) {
+    counting_state_t *state = (counting_state_t *)arg;
+    state->reads++;
+    return *state->string++;
+}
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+    InSequence s;
+
+    uint32_t start = timer_read32();
+    EXPECT_NO_REPORT(driver);
+    send_string_async("ab" SS_DELAY(500) "c");
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(400);
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(110);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SendsOneReportPerMillisecond) {
+    TestDriver driver;
+    InSequence s;
+
+    send_string_async("A" SS_TAP(X_ENTER));
+    // Queued output starts on the next millisecond
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_ENTER));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Done once the host has had a polling interval to pick up the last report
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, SynchronousSendFlushesFirst) {
+    TestDriver driver;
+    InSequence s;
+
+    // The blocking API has typed everything out by the time it returns, so anything after it comes last
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("a");
+    send_string("b");
+    tap_code(KC_ENTER);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, FlushTypesEverythingOut) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("ab");
+    send_string_async_flush();
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    send_string_async(SS_DOWN(X_LCTL) SS_DELAY(100) "x" SS_UP(X_LCTL));
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesKeysHeldBySentOutput) {
+    TestDriver driver;
+    InSequence s;
+
+    // The release is not part of this string, so it is never queued
+    send_string_async(SS_DOWN(X_LSFT) SS_DELAY(100) "x");
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, LongStringsAreQueuedWithoutBlocking) {
+    TestDriver  driver;
+    std::string string(SEND_STRING_ASYNC_TEXT_SIZE, 'a');
+
+    // Each character is a press and a release, many more than the event queue holds
+    uint32_t start = timer_read32();
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async(string.c_str()));
+    EXPECT_EQ(timer_read32(), start);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(2 * string.size());
+    idle_for(100);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, StringsThatDoNotFitAreNotSent) {
+    TestDriver  driver;
+    std::string string(SEND_STRING_ASYNC_TEXT_SIZE, 'a');
+
+    // Only the first few characters are decoded straight away, the rest stay in the text buffer
+    EXPECT_TRUE(send_string_async(string.c_str()));
+    EXPECT_FALSE(send_string_async("bbbbbbbbbbbbbbbb"));
+
+    // Only the first string is typed out
+    EXPECT_ANY_REPORT(driver).Times(2 * string.size());
+    idle_for(100);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    // Once typed out, there is room again
+    EXPECT_TRUE(send_string_async("bbbbbbbbbbbbbbbb"));
+}
+
+TEST_F(SendStringAsync, TooManyStringsAreNotSent) {
+    TestDriver driver;
+
+    // Long enough that none of them is completely decoded straight away
+    for (int i = 0; i < SEND_STRING_ASYNC_MAX_STRINGS; i++) {
+        EXPECT_TRUE(send_string_async("abcdef"));
+    }
+    EXPECT_FALSE(send_string_async("g"));
+
+    EXPECT_ANY_REPORT(driver).Times(2 * 6 * SEND_STRING_ASYNC_MAX_STRINGS);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, StreamsLongStringsWithoutBlocking) {
+    TestDriver       driver;
+    std::string      string(200, 'a');
+    counting_state_t state = {string.c_str(), 0};
+
+    uint32_t start = timer_read32();
+    EXPECT_NO_REPORT(driver);
+    send_string_with_delay_async_stream(counting_getter, &state, 0);
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_LE(state.reads, SEND_STRING_ASYNC_BUFFER_SIZE);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(2 * 200);
+    idle_for(500);
+    EXPECT_FALSE(send_string_async_busy());
+    EXPECT_EQ(state.reads, 201);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, StringsQueueBehindStreams) {
+    TestDriver       driver;
+    std::string      string(20, 'a');
+    counting_state_t state = {string.c_str(), 0};
+    InSequence       s;
+
+    uint32_t start = timer_read32();
+    EXPECT_NO_REPORT(driver);
+    send_string_with_delay_async_stream(counting_getter, &state, 0);
+    send_string_async("b");
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_LE(state.reads, SEND_STRING_ASYNC_BUFFER_SIZE);
+    VERIFY_AND_CLEAR(driver);
+
+    for (size_t i = 0; i < string.size(); i++) {
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(100);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,139 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class WaitingBuffer : public TestFixture {
+   protected:
+    void SetUp() override {
+        waiting_buffer_reset_stats();
+    }
+
+    static waiting_buffer_stats_t stats(void) {
+        waiting_buffer_stats_t result;
+        waiting_buffer_get_stats(&result);
+        return result;
+    }
+};
+
+TEST_F(WaitingBuffer, roll_within_capacity_tracks_high_water_mark) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       key_a       = KeymapKey(0, 2, 0, KC_A);
+    auto       key_b       = KeymapKey(0, 3, 0, KC_B);
+
+    set_keymap({mod_tap_key, key_a, key_b});
+
+    /* Roll: the presses are held back until the mod-tap key is released */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_P, KC_A));
+    EXPECT_REPORT(driver, (KC_P, KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(stats().size, WAITING_BUFFER_SIZE - 1);
+    /* Both presses, plus the mod-tap release which is queued behind them */
+    EXPECT_EQ(stats().high_water, 3);
+    EXPECT_EQ(stats().overflow_count, 0);
+    EXPECT_EQ(stats().dropped_count, 0);
+}
+
+TEST_F(WaitingBuffer, overflow_is_counted) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       key_a       = KeymapKey(0, 2, 0, KC_A);
+    auto       key_b       = KeymapKey(0, 3, 0, KC_B);
+    auto       key_c       = KeymapKey(0, 4, 0, KC_C);
+
+    set_keymap({mod_tap_key, key_a, key_b, key_c});
+
+    /* Fill the buffer with three events, then overflow it with a fourth */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(stats().high_water, 3);
+    EXPECT_EQ(stats().overflow_count, 0);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_c.press();
+    run_one_scan_loop();
+    EXPECT_EQ(stats().overflow_count, 1);
+    EXPECT_EQ(stats().dropped_count, 4);
+
+    mod_tap_key.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(WaitingBuffer, raw_hid_reports_and_resets_stats) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       key_a       = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_key, key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    mod_tap_key.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    mod_tap_key.release();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    uint8_t data[32] = {WAITING_BUFFER_RAW_HID_ID, 0x01};
+    EXPECT_TRUE(waiting_buffer_raw_hid_command(data, sizeof(data)));
+    EXPECT_EQ(data[1], 0);
+    EXPECT_EQ(data[2], WAITING_BUFFER_SIZE - 1);
+    EXPECT_EQ(data[3], 2);
+    EXPECT_EQ(data[4] | (data[5] << 8), 0);
+    EXPECT_EQ(data[6] | (data[7] << 8), 0);
+
+    /* Bit 0 of the flags reset the statistics once read */
+    EXPECT_EQ(stats().high_water, 0);
+
+    data[0] = WAITING_BUFFER_RAW_HID_ID + 1;
+    EXPECT_FALSE(waiting_buffer_raw_hid_command(data, sizeof(data)));
+}
@@ -50,7 +50,7 @@ struct KeymapKey {
    private:
     void validate() {
         assert(position.col <= MATRIX_COLS);
-        assert(position.row <= MATRIX_ROWS);
+        assert(position.row <= MATRIX_ROWS || position.row == KEYLOC_ENCODER_CW || position.row == KEYLOC_ENCODER_CCW);
     }
     uint32_t timestamp_pressed;
 };
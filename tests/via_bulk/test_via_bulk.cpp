@@ -0,0 +1,78 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "via_bulk_fixture.hpp"
+
+TEST_F(ViaBulk, Crc16MatchesReference) {
+    const uint8_t check[] = "123456789";
+    EXPECT_EQ(via_bulk_crc16(0xFFFF, check, 9), 0x29B1);
+}
+
+TEST_F(ViaBulk, ReadStreamsWholeKeymap) {
+    set_keymap_with_transparent_layers();
+
+    size_t packets = 0;
+    EXPECT_EQ(read(0, &packets), keymap());
+    EXPECT_EQ(packets, (KEYMAP_SIZE + PAYLOAD_SIZE - 1) / PAYLOAD_SIZE);
+}
+
+TEST_F(ViaBulk, ReadCompressesTransparentLayers) {
+    set_keymap_with_transparent_layers();
+
+    size_t raw_packets = 0, rle_packets = 0;
+    EXPECT_EQ(read(0, &raw_packets), keymap());
+    EXPECT_EQ(read(VIA_BULK_FLAG_RLE, &rle_packets), keymap());
+    EXPECT_LT(rle_packets * 2, raw_packets);
+}
+
+TEST_F(ViaBulk, WriteAppliesOnlyOnCommit) {
+    set_keymap_with_transparent_layers();
+    std::vector<uint8_t> original = keymap();
+
+    std::vector<uint8_t> data(KEYMAP_SIZE, 0);
+    for (size_t i = 0; i < data.size(); i += 2) {
+        uint16_t keycode = (i / 2) % 7 == 0 ? KC_B : KC_TRANSPARENT;
+        data[i]          = keycode >> 8;
+        data[i + 1]      = keycode & 0xFF;
+    }
+    uint16_t crc = via_bulk_crc16(0xFFFF, data.data(), data.size());
+
+    command({id_via_bulk_write_begin, VIA_BULK_FLAG_RLE, KEYMAP_SIZE >> 8, KEYMAP_SIZE & 0xFF});
+    take_packet();
+    EXPECT_EQ(keymap(), original);
+
+    EXPECT_EQ(write(data, VIA_BULK_FLAG_RLE, crc), VIA_BULK_STATUS_OK);
+    EXPECT_EQ(keymap(), data);
+
+    std::reverse(data.begin(), data.end());
+    crc = via_bulk_crc16(0xFFFF, data.data(), data.size());
+    EXPECT_EQ(write(data, 0, crc), VIA_BULK_STATUS_OK);
+    EXPECT_EQ(keymap(), data);
+}
+
+TEST_F(ViaBulk, WriteRejectsCorruptTransfers) {
+    set_keymap_with_transparent_layers();
+    std::vector<uint8_t> original = keymap();
+
+    std::vector<uint8_t> data(KEYMAP_SIZE);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i * 37;
+    }
+    uint16_t crc = via_bulk_crc16(0xFFFF, data.data(), data.size());
+
+    EXPECT_EQ(write(data, 0, crc ^ 1), VIA_BULK_STATUS_CRC);
+    EXPECT_EQ(keymap(), original);
+
+    EXPECT_EQ(write(data, 0, crc, 3), VIA_BULK_STATUS_SEQUENCE);
+    EXPECT_EQ(keymap(), original);
+
+    data.resize(KEYMAP_SIZE - 2);
+    command({id_via_bulk_write_begin, 0, KEYMAP_SIZE >> 8, KEYMAP_SIZE & 0xFF});
+    take_packet();
+    command({id_via_bulk_write_commit, (uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF)});
+    EXPECT_EQ(take_packet()[2], VIA_BULK_STATUS_SIZE);
+    EXPECT_EQ(keymap(), original);
+
+    command({id_via_bulk_write_begin, 0, (KEYMAP_SIZE + 2) >> 8, (KEYMAP_SIZE + 2) & 0xFF});
+    EXPECT_EQ(take_packet()[2], VIA_BULK_STATUS_SIZE);
+}
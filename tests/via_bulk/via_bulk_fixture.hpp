@@ -0,0 +1,197 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <deque>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "host.h"
+#include "via_bulk.h"
+}
+
+namespace {
+
+constexpr uint8_t  PACKET_SIZE  = 32;
+constexpr uint8_t  PAYLOAD_SIZE = PACKET_SIZE - VIA_BULK_HEADER_SIZE;
+constexpr uint16_t KEYMAP_SIZE  = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+
+using packet_t = std::vector<uint8_t>;
+
+std::deque<packet_t> sent_packets;
+
+void send_raw_hid(uint8_t* data, uint8_t length) {
+    sent_packets.emplace_back(data, data + length);
+}
+
+host_driver_t raw_hid_driver = {
+    .keyboard_leds = []() -> uint8_t { return 0; },
+    .send_keyboard = [](report_keyboard_t*) {},
+    .send_nkro     = [](report_nkro_t*) {},
+    .send_mouse    = [](report_mouse_t*) {},
+    .send_extra    = [](report_extra_t*) {},
+    .send_raw_hid  = send_raw_hid,
+};
+
+/* Host side reference implementation of the run-length encoding. */
+std::vector<uint8_t> rle_encode(const std::vector<uint8_t>& data) {
+    std::vector<uint16_t> keycodes;
+    for (size_t i = 0; i < data.size(); i += 2) {
+        keycodes.push_back((data[i] << 8) | data[i + 1]);
+    }
+    std::vector<uint8_t> out;
+    size_t               pos = 0;
+    while (pos < keycodes.size()) {
+        size_t run = 1;
+        while (pos + run < keycodes.size() && run < 129 && keycodes[pos + run] == keycodes[pos]) {
+            run++;
+        }
+        if (run >= 2) {
+            out.push_back(0x80 | (run - 2));
+            out.push_back(keycodes[pos] >> 8);
+            out.push_back(keycodes[pos] & 0xFF);
+            pos += run;
+            continue;
+        }
+        size_t literal = 1;
+        while (pos + literal < keycodes.size() && literal < 128 && !(pos + literal + 1 < keycodes.size() && keycodes[pos + literal] == keycodes[pos + literal + 1])) {
+            literal++;
+        }
+        out.push_back(literal - 1);
+        for (size_t i = 0; i < literal; i++) {
+            out.push_back(keycodes[pos + i] >> 8);
+            out.push_back(keycodes[pos + i] & 0xFF);
+        }
+        pos += literal;
+    }
+    return out;
+}
+
+std::vector<uint8_t> rle_decode(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    size_t               pos = 0;
+    while (pos < data.size()) {
+        uint8_t token = data[pos++];
+        if (token & 0x80) {
+            for (int i = 0; i < (token & 0x7F) + 2; i++) {
+                out.push_back(data[pos]);
+                out.push_back(data[pos + 1]);
+            }
+            pos += 2;
+        } else {
+            for (int i = 0; i <= token; i++) {
+                out.push_back(data[pos++]);
+                out.push_back(data[pos++]);
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+class ViaBulk : public TestFixture {
+   protected:
+    void SetUp() override {
+        host_set_driver(&raw_hid_driver);
+        sent_packets.clear();
+        command({id_via_bulk_abort});
+        sent_packets.clear();
+    }
+
+    void TearDown() override {
+        host_set_driver(nullptr);
+    }
+
+    packet_t command(std::initializer_list<uint8_t> fields) {
+        packet_t packet(PACKET_SIZE, 0);
+        packet[0] = VIA_BULK_RAW_HID_ID;
+        std::copy(fields.begin(), fields.end(), packet.begin() + 1);
+        EXPECT_TRUE(via_bulk_command(packet.data(), packet.size()));
+        return packet;
+    }
+
+    packet_t take_packet() {
+        EXPECT_FALSE(sent_packets.empty());
+        if (sent_packets.empty()) {
+            return packet_t(PACKET_SIZE, 0xFF);
+        }
+        packet_t packet = sent_packets.front();
+        sent_packets.pop_front();
+        return packet;
+    }
+
+    std::vector<uint8_t> keymap() {
+        std::vector<uint8_t> buffer(KEYMAP_SIZE);
+        dynamic_keymap_get_buffer(0, KEYMAP_SIZE, buffer.data());
+        return buffer;
+    }
+
+    void set_keymap_with_transparent_layers() {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    dynamic_keymap_set_keycode(layer, row, col, layer == 0 ? KC_A + row * MATRIX_COLS + col : KC_TRANSPARENT);
+                }
+            }
+        }
+    }
+
+    /* Streams a whole read, returning the payload and the number of data packets. */
+    std::vector<uint8_t> read(uint8_t flags, size_t* packet_count) {
+        command({id_via_bulk_read_begin, flags});
+        packet_t begin = take_packet();
+        EXPECT_EQ(begin[2], VIA_BULK_STATUS_OK);
+        EXPECT_EQ((begin[3] << 8) | begin[4], KEYMAP_SIZE);
+
+        std::vector<uint8_t> payload;
+        uint8_t              sequence = 0;
+        for (int i = 0; i < 1000; i++) {
+            via_bulk_task();
+            packet_t packet = take_packet();
+            if (packet[1] == id_via_bulk_read_end) {
+                EXPECT_EQ(packet[2], VIA_BULK_STATUS_OK);
+                EXPECT_EQ(packet[5], sequence);
+                *packet_count = sequence;
+                std::vector<uint8_t> data = (flags & VIA_BULK_FLAG_RLE) ? rle_decode(payload) : payload;
+                EXPECT_EQ((packet[3] << 8) | packet[4], via_bulk_crc16(0xFFFF, data.data(), data.size()));
+                return data;
+            }
+            EXPECT_EQ(packet[1], id_via_bulk_read_data);
+            EXPECT_EQ(packet[2], sequence++);
+            payload.insert(payload.end(), packet.begin() + VIA_BULK_HEADER_SIZE, packet.begin() + VIA_BULK_HEADER_SIZE + packet[3]);
+        }
+        ADD_FAILURE() << "read stream never ended";
+        return {};
+    }
+
+    /* Sends a whole write without waiting for replies, optionally dropping one data packet. */
+    uint8_t write(const std::vector<uint8_t>& data, uint8_t flags, uint16_t crc, int drop = -1) {
+        command({id_via_bulk_write_begin, flags, (uint8_t)(data.size() >> 8), (uint8_t)(data.size() & 0xFF)});
+        EXPECT_EQ(take_packet()[2], VIA_BULK_STATUS_OK);
+
+        std::vector<uint8_t> payload = (flags & VIA_BULK_FLAG_RLE) ? rle_encode(data) : data;
+        uint8_t              sequence = 0;
+        for (size_t offset = 0; offset < payload.size(); offset += PAYLOAD_SIZE) {
+            uint8_t  length = std::min<size_t>(PAYLOAD_SIZE, payload.size() - offset);
+            packet_t packet(PACKET_SIZE, 0);
+            packet[0] = VIA_BULK_RAW_HID_ID;
+            packet[1] = id_via_bulk_write_data;
+            packet[2] = sequence++;
+            packet[3] = length;
+            std::copy(payload.begin() + offset, payload.begin() + offset + length, packet.begin() + VIA_BULK_HEADER_SIZE);
+            if (drop-- != 0) {
+                EXPECT_TRUE(via_bulk_command(packet.data(), packet.size()));
+            }
+        }
+        EXPECT_TRUE(sent_packets.empty()) << "data packets must not be acknowledged";
+
+        command({id_via_bulk_write_commit, (uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF)});
+        return take_packet()[2];
+    }
+};
@@ -0,0 +1,37 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "../via_bulk_fixture.hpp"
+
+TEST_F(ViaBulk, WriteThroughAppliesWholeKeymap) {
+    set_keymap_with_transparent_layers();
+
+    std::vector<uint8_t> data(KEYMAP_SIZE, 0);
+    for (size_t i = 0; i < data.size(); i += 2) {
+        uint16_t keycode = (i / 2) % 7 == 0 ? KC_B : KC_TRANSPARENT;
+        data[i]          = keycode >> 8;
+        data[i + 1]      = keycode & 0xFF;
+    }
+    uint16_t crc = via_bulk_crc16(0xFFFF, data.data(), data.size());
+    EXPECT_EQ(write(data, VIA_BULK_FLAG_RLE, crc), VIA_BULK_STATUS_OK);
+    EXPECT_EQ(keymap(), data);
+
+    std::reverse(data.begin(), data.end());
+    crc = via_bulk_crc16(0xFFFF, data.data(), data.size());
+    EXPECT_EQ(write(data, 0, crc), VIA_BULK_STATUS_OK);
+    EXPECT_EQ(keymap(), data);
+}
+
+TEST_F(ViaBulk, WriteThroughReportsCorruptTransfers) {
+    std::vector<uint8_t> data(KEYMAP_SIZE);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i * 37;
+    }
+    uint16_t crc = via_bulk_crc16(0xFFFF, data.data(), data.size());
+
+    // Without staging the data has already been written, but the host is still told it was corrupted
+    EXPECT_EQ(write(data, 0, crc ^ 1), VIA_BULK_STATUS_CRC);
+    EXPECT_EQ(keymap(), data);
+
+    EXPECT_EQ(write(data, 0, crc, 3), VIA_BULK_STATUS_SEQUENCE);
+}
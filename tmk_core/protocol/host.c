@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode.h"
 #include "action.h"
@@ -23,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "debug.h"
 #include "usb_device_state.h"
+#include "timer.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -71,8 +73,218 @@ static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+#ifdef HOST_REPORT_COALESCING
+#    ifndef HOST_REPORT_COALESCING_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define HOST_REPORT_COALESCING_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define HOST_REPORT_COALESCING_INTERVAL 1
+#        endif
+#    endif
+
+/*
+ * Reports are forwarded straight away if nothing was sent to the endpoint during the current interval. Otherwise they
+ * are held as pending, and any further reports within the interval are merged into it, as long as the host sees the
+ * same sequence of key transitions it otherwise would. Pending reports are flushed from host_task().
+ *
+ * Reports that release a key or button are never held, as host_task() doesn't run during a blocking wait (tap_code()
+ * followed by wait_ms(), SS_DELAY(), ...) and the host would see the key as held, and start repeating it.
+ */
+typedef struct {
+    bool     pending;
+    uint32_t last_send;
+} host_coalesce_t;
+
+static host_coalesce_t   keyboard_coalesce;
+static report_keyboard_t keyboard_sent;
+static report_keyboard_t keyboard_pending;
+#    ifdef NKRO_ENABLE
+static host_coalesce_t nkro_coalesce;
+static report_nkro_t   nkro_sent;
+static report_nkro_t   nkro_pending;
+#    endif
+static host_coalesce_t mouse_coalesce;
+static report_mouse_t  mouse_pending;
+static uint8_t         mouse_sent_buttons;
+
+static bool host_coalesce_ready(host_coalesce_t *state) {
+    return TIMER_DIFF_32(timer_read32(), state->last_send) >= HOST_REPORT_COALESCING_INTERVAL;
+}
+
+static void host_coalesce_reset(void) {
+    // The first report to a new driver goes out straight away
+    uint32_t last_send = timer_read32() - HOST_REPORT_COALESCING_INTERVAL;
+
+    keyboard_coalesce = (host_coalesce_t){.pending = false, .last_send = last_send};
+    memset(&keyboard_sent, 0, sizeof(keyboard_sent));
+#    ifdef NKRO_ENABLE
+    nkro_coalesce = (host_coalesce_t){.pending = false, .last_send = last_send};
+    memset(&nkro_sent, 0, sizeof(nkro_sent));
+#    endif
+    mouse_coalesce     = (host_coalesce_t){.pending = false, .last_send = last_send};
+    mouse_sent_buttons = 0;
+}
+
+static bool keyboard_report_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool keyboard_report_keys_equal(const report_keyboard_t *a, const report_keyboard_t *b) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if ((a->keys[i] && !keyboard_report_has_key(b, a->keys[i])) || (b->keys[i] && !keyboard_report_has_key(a, b->keys[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool keyboard_report_releases(const report_keyboard_t *last, const report_keyboard_t *next) {
+    if (last->mods & ~next->mods) {
+        return true;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (last->keys[i] && !keyboard_report_has_key(next, last->keys[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Each key and modifier may only change once between the last sent report and the merged one, otherwise a tap or
+ * release would be lost. Modifier changes are not merged with later key changes (or vice versa) either, as the host
+ * would then see them happening at the same time rather than in order.
+ */
+static bool keyboard_report_can_merge(const report_keyboard_t *sent, const report_keyboard_t *pending, const report_keyboard_t *next) {
+    if ((sent->mods ^ pending->mods) & (pending->mods ^ next->mods)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t pressed  = pending->keys[i];
+        uint8_t released = sent->keys[i];
+        if (pressed && !keyboard_report_has_key(sent, pressed) && !keyboard_report_has_key(next, pressed)) {
+            return false;
+        }
+        if (released && !keyboard_report_has_key(pending, released) && keyboard_report_has_key(next, released)) {
+            return false;
+        }
+    }
+
+    bool pending_mods = sent->mods != pending->mods;
+    bool next_mods    = pending->mods != next->mods;
+    bool pending_keys = !keyboard_report_keys_equal(sent, pending);
+    bool next_keys    = !keyboard_report_keys_equal(pending, next);
+    return !((pending_mods && next_keys) || (pending_keys && next_mods));
+}
+
+#    ifdef NKRO_ENABLE
+static bool nkro_report_releases(const report_nkro_t *last, const report_nkro_t *next) {
+    if (last->mods & ~next->mods) {
+        return true;
+    }
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if (last->bits[i] & ~next->bits[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool nkro_report_can_merge(const report_nkro_t *sent, const report_nkro_t *pending, const report_nkro_t *next) {
+    if ((sent->mods ^ pending->mods) & (pending->mods ^ next->mods)) {
+        return false;
+    }
+
+    bool pending_keys = false;
+    bool next_keys    = false;
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if ((sent->bits[i] ^ pending->bits[i]) & (pending->bits[i] ^ next->bits[i])) {
+            return false;
+        }
+        pending_keys |= sent->bits[i] != pending->bits[i];
+        next_keys |= pending->bits[i] != next->bits[i];
+    }
+
+    bool pending_mods = sent->mods != pending->mods;
+    bool next_mods    = pending->mods != next->mods;
+    return !((pending_mods && next_keys) || (pending_keys && next_mods));
+}
+#    endif
+
+static bool mouse_report_merge(report_mouse_t *pending, const report_mouse_t *next) {
+    // Button changes are kept in order with respect to movement
+    if (pending->buttons != next->buttons) {
+        return false;
+    }
+
+    int32_t x = (int32_t)pending->x + next->x;
+    int32_t y = (int32_t)pending->y + next->y;
+    int32_t v = (int32_t)pending->v + next->v;
+    int32_t h = (int32_t)pending->h + next->h;
+    if (x < MOUSE_REPORT_XY_MIN || x > MOUSE_REPORT_XY_MAX || y < MOUSE_REPORT_XY_MIN || y > MOUSE_REPORT_XY_MAX || v < MOUSE_REPORT_HV_MIN || v > MOUSE_REPORT_HV_MAX || h < MOUSE_REPORT_HV_MIN || h > MOUSE_REPORT_HV_MAX) {
+        return false;
+    }
+
+    pending->x = x;
+    pending->y = y;
+    pending->v = v;
+    pending->h = h;
+    return true;
+}
+
+static void host_keyboard_send_now(report_keyboard_t *report);
+#    ifdef NKRO_ENABLE
+static void host_nkro_send_now(report_nkro_t *report);
+#    endif
+static void host_mouse_send_now(report_mouse_t *report);
+
+#    ifdef CONNECTION_ENABLE
+static void host_coalesce_flush(void) {
+    if (keyboard_coalesce.pending) {
+        keyboard_coalesce.pending = false;
+        host_keyboard_send_now(&keyboard_pending);
+    }
+#    ifdef NKRO_ENABLE
+    if (nkro_coalesce.pending) {
+        nkro_coalesce.pending = false;
+        host_nkro_send_now(&nkro_pending);
+    }
+#    endif
+    if (mouse_coalesce.pending) {
+        mouse_coalesce.pending = false;
+        host_mouse_send_now(&mouse_pending);
+    }
+}
+#    endif
+
+static void host_coalesce_task(void) {
+    if (keyboard_coalesce.pending && host_coalesce_ready(&keyboard_coalesce)) {
+        keyboard_coalesce.pending = false;
+        host_keyboard_send_now(&keyboard_pending);
+    }
+#    ifdef NKRO_ENABLE
+    if (nkro_coalesce.pending && host_coalesce_ready(&nkro_coalesce)) {
+        nkro_coalesce.pending = false;
+        host_nkro_send_now(&nkro_pending);
+    }
+#    endif
+    if (mouse_coalesce.pending && host_coalesce_ready(&mouse_coalesce)) {
+        mouse_coalesce.pending = false;
+        host_mouse_send_now(&mouse_pending);
+    }
+}
+#endif // HOST_REPORT_COALESCING
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
+#ifdef HOST_REPORT_COALESCING
+    host_coalesce_reset();
+#endif
 }
 
 host_driver_t *host_get_driver(void) {
@@ -90,6 +302,12 @@ __attribute__((weak)) void host_connect_active_driver_kb(connection_host_t host)
 
 // TODO: Additionally have host_driver_t handle swap
 static void host_update_active_driver(connection_host_t current, connection_host_t next) {
+#    ifdef HOST_REPORT_COALESCING
+    // Anything pending belongs to the outgoing host
+    host_coalesce_flush();
+    host_coalesce_reset();
+#    endif
+
     host_disconnect_active_driver_user(current);
     host_disconnect_active_driver_kb(current);
 
@@ -116,6 +334,10 @@ void host_task(void) {
         active_host = next_host;
     }
 #endif
+
+#ifdef HOST_REPORT_COALESCING
+    host_coalesce_task();
+#endif
 }
 
 static host_driver_t *host_get_active_driver(void) {
@@ -174,7 +396,29 @@ led_t host_keyboard_led_state(void) {
 }
 
 /* send report */
+#ifdef HOST_REPORT_COALESCING
+void host_keyboard_send(report_keyboard_t *report) {
+    bool release = keyboard_report_releases(keyboard_coalesce.pending ? &keyboard_pending : &keyboard_sent, report);
+
+    if (keyboard_coalesce.pending) {
+        keyboard_coalesce.pending = false;
+        if (!keyboard_report_can_merge(&keyboard_sent, &keyboard_pending, report)) {
+            // Keep the transition ordering by sending the pending report first
+            host_keyboard_send_now(&keyboard_pending);
+        }
+    }
+    if (!release && !host_coalesce_ready(&keyboard_coalesce)) {
+        keyboard_coalesce.pending = true;
+        keyboard_pending          = *report;
+        return;
+    }
+    host_keyboard_send_now(report);
+}
+
+static void host_keyboard_send_now(report_keyboard_t *report) {
+#else
 void host_keyboard_send(report_keyboard_t *report) {
+#endif
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_keyboard) return;
 
@@ -182,6 +426,10 @@ void host_keyboard_send(report_keyboard_t *report) {
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
     (*driver->send_keyboard)(report);
+#ifdef HOST_REPORT_COALESCING
+    keyboard_sent               = *report;
+    keyboard_coalesce.last_send = timer_read32();
+#endif
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);
@@ -192,12 +440,37 @@ void host_keyboard_send(report_keyboard_t *report) {
     }
 }
 
+#if defined(HOST_REPORT_COALESCING) && defined(NKRO_ENABLE)
+void host_nkro_send(report_nkro_t *report) {
+    bool release = nkro_report_releases(nkro_coalesce.pending ? &nkro_pending : &nkro_sent, report);
+
+    if (nkro_coalesce.pending) {
+        nkro_coalesce.pending = false;
+        if (!nkro_report_can_merge(&nkro_sent, &nkro_pending, report)) {
+            host_nkro_send_now(&nkro_pending);
+        }
+    }
+    if (!release && !host_coalesce_ready(&nkro_coalesce)) {
+        nkro_coalesce.pending = true;
+        nkro_pending          = *report;
+        return;
+    }
+    host_nkro_send_now(report);
+}
+
+static void host_nkro_send_now(report_nkro_t *report) {
+#else
 void host_nkro_send(report_nkro_t *report) {
+#endif
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_nkro) return;
 
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
+#if defined(HOST_REPORT_COALESCING) && defined(NKRO_ENABLE)
+    nkro_sent               = *report;
+    nkro_coalesce.last_send = timer_read32();
+#endif
 
     if (debug_keyboard) {
         dprintf("nkro_report: %02X | ", report->mods);
@@ -208,7 +481,29 @@ void host_nkro_send(report_nkro_t *report) {
     }
 }
 
+#ifdef HOST_REPORT_COALESCING
 void host_mouse_send(report_mouse_t *report) {
+    bool release = (mouse_coalesce.pending ? mouse_pending.buttons : mouse_sent_buttons) & ~report->buttons;
+
+    if (mouse_coalesce.pending) {
+        if (mouse_report_merge(&mouse_pending, report)) {
+            return;
+        }
+        mouse_coalesce.pending = false;
+        host_mouse_send_now(&mouse_pending);
+    }
+    if (!release && !host_coalesce_ready(&mouse_coalesce)) {
+        mouse_coalesce.pending = true;
+        mouse_pending          = *report;
+        return;
+    }
+    host_mouse_send_now(report);
+}
+
+static void host_mouse_send_now(report_mouse_t *report) {
+#else
+void host_mouse_send(report_mouse_t *report) {
+#endif
     host_driver_t *driver = host_get_active_driver();
     if (!driver || !driver->send_mouse) return;
 
@@ -221,6 +516,10 @@ void host_mouse_send(report_mouse_t *report) {
     report->boot_y = (report->y > 127) ? 127 : ((report->y < -127) ? -127 : report->y);
 #endif
     (*driver->send_mouse)(report);
+#ifdef HOST_REPORT_COALESCING
+    mouse_sent_buttons       = report->buttons;
+    mouse_coalesce.last_send = timer_read32();
+#endif
 }
 
 void host_system_send(uint16_t usage) {